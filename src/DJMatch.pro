@@ -6,7 +6,7 @@
 
 QT =
 
-CONFIG += c++17 c++1z
+CONFIG += c++17 c++1z thread
 
 TARGET = DJMatch
 CONFIG -= app_bundle
@@ -49,26 +49,69 @@ debugsymbols {
 	QMAKE_CXXFLAGS_RELEASE += -fno-omit-frame-pointer -g
 }
 
+noprefetch {
+  DEFINES += DJM_PREFETCH_WINDOW=0
+}
+
+nophasetimers {
+  DEFINES += DJM_PHASE_TIMERS=0
+}
+
 SOURCES += extern/argtable3-3.0.3/argtable3.c \
       main.cpp \
+      tools/allocation_counter.cpp \
       matching/node_centered.cpp \
       matching/greedy_iterative.cpp \
       matching/greedy_b_matching.cpp \
       matching/gpa/gpa.cpp \
+      matching/gpa/gpa_multi_seed.cpp \
+      matching/algorithm_factory.cpp \
+      matching/normalized_graph.cpp \
+      matching/upper_bounds.cpp \
+      matching/solution_io.cpp \
+      matching/solution_writer.cpp \
+      matching/matching_stream.cpp \
+      matching/portfolio.cpp \
+      matching/dynamic/k_matching_repair.cpp \
+      matching/dynamic/demand_window.cpp \
+      matching/components/connected_components.cpp \
+      matching/components/component_solver.cpp \
       matching/coloring/misra_gries.cpp
 
 HEADERS += extern/argtable3-3.0.3/argtable3.h \
       tools/chronotimer.h \
+      tools/parallel.h \
+      tools/blocking_queue.h \
+      tools/memory_usage.h \
+      tools/perf_counters.h \
+      tools/trace.h \
+      tools/allocation_counter.h \
       djmatch_info.h \
+      results_csv.h \
       matching/matching_defs.h \
       matching/matching_config.h \
       matching/matching_algorithm.h \
+      matching/event_counters.h \
+      matching/prefetch_scan.h \
       matching/node_centered.h \
       matching/greedy_iterative.h \
       matching/greedy_b_matching.h \
       matching/gpa/path.h \
       matching/gpa/path_set.h \
       matching/gpa/gpa.h \
+      matching/gpa/weight_buckets.h \
+      matching/gpa/gpa_multi_seed.h \
+      matching/algorithm_factory.h \
+      matching/normalized_graph.h \
+      matching/upper_bounds.h \
+      matching/solution_io.h \
+      matching/solution_writer.h \
+      matching/matching_stream.h \
+      matching/portfolio.h \
+      matching/dynamic/k_matching_repair.h \
+      matching/dynamic/demand_window.h \
+      matching/components/connected_components.h \
+      matching/components/component_solver.h \
       matching/coloring/misra_gries.h \
       matching/coloring/k_edge_coloring.hpp
 
@@ -0,0 +1,146 @@
+########################################################################
+# Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer         #
+#                                                                      #
+# This file is part of DJMatch and licensed under GPLv3.               #
+########################################################################
+
+QT =
+
+CONFIG += c++17 c++1z thread
+
+TARGET = DJMatchBench
+CONFIG -= app_bundle
+
+TEMPLATE = app
+OBJECTS_DIR = $$TARGET-obj
+
+DJMINFOHDRTMPL = $$PWD/djmatch_info.TEMPLATE.h
+DJMINFOHDR = $$PWD/djmatch_info.h
+djminfotarget.target =  $$DJMINFOHDR
+djminfotarget.commands = '$$PWD/../updateInfoHeader $$DJMINFOHDRTMPL $$DJMINFOHDR'
+djminfotarget.depends = FORCE $$DJMINFOHDRTMPL
+PRE_TARGETDEPS += $$DJMINFOHDR
+QMAKE_EXTRA_TARGETS += djminfotarget
+
+QMAKE_CXXFLAGS_APP =
+QMAKE_CXXFLAGS_STATIC_LIB = # remove -fPIC
+
+QMAKE_CXXFLAGS_DEBUG += -std=c++17 -O0
+QMAKE_LFLAGS_DEBUG +=
+
+QMAKE_CXXFLAGS_RELEASE -= -O3 -O2 -O1
+QMAKE_CXXFLAGS_RELEASE += -std=c++17 -DNDEBUG -flto
+QMAKE_LFLAGS_RELEASE += -flto -O3
+
+custom-ar {
+  QMAKE_AR += rcs
+} else {
+  QMAKE_AR -= cqs
+  QMAKE_AR -= cq
+  QMAKE_AR += rcs
+}
+
+general {
+  QMAKE_CXXFLAGS_RELEASE += -O2 -march=x86-64
+} else {
+  QMAKE_CXXFLAGS_RELEASE += -O3 -march=native -mtune=native
+}
+
+debugsymbols {
+	QMAKE_CXXFLAGS_RELEASE += -fno-omit-frame-pointer -g
+}
+
+noprefetch {
+  DEFINES += DJM_PREFETCH_WINDOW=0
+}
+
+nophasetimers {
+  DEFINES += DJM_PHASE_TIMERS=0
+}
+
+SOURCES += extern/argtable3-3.0.3/argtable3.c \
+      bench/bench_main.cpp \
+      bench/generators.cpp \
+      bench/bench_statistics.cpp \
+      bench/json_reader.cpp \
+      bench/regression.cpp \
+      bench/pareto.cpp \
+      tools/allocation_counter.cpp \
+      matching/node_centered.cpp \
+      matching/greedy_iterative.cpp \
+      matching/greedy_b_matching.cpp \
+      matching/gpa/gpa.cpp \
+      matching/gpa/gpa_multi_seed.cpp \
+      matching/algorithm_factory.cpp \
+      matching/normalized_graph.cpp \
+      matching/upper_bounds.cpp \
+      matching/solution_io.cpp \
+      matching/solution_writer.cpp \
+      matching/matching_stream.cpp \
+      matching/portfolio.cpp \
+      matching/dynamic/k_matching_repair.cpp \
+      matching/dynamic/demand_window.cpp \
+      matching/components/connected_components.cpp \
+      matching/components/component_solver.cpp \
+      matching/coloring/misra_gries.cpp
+
+HEADERS += extern/argtable3-3.0.3/argtable3.h \
+      tools/chronotimer.h \
+      tools/parallel.h \
+      tools/blocking_queue.h \
+      tools/memory_usage.h \
+      tools/perf_counters.h \
+      tools/trace.h \
+      bench/bench_config.h \
+      bench/parse_bench_parameters.h \
+      bench/generators.h \
+      bench/bench_statistics.h \
+      bench/json_reader.h \
+      bench/regression.h \
+      bench/pareto.h \
+      tools/allocation_counter.h \
+      results_csv.h \
+      djmatch_info.h \
+      matching/matching_defs.h \
+      matching/matching_config.h \
+      matching/matching_algorithm.h \
+      matching/event_counters.h \
+      matching/prefetch_scan.h \
+      matching/node_centered.h \
+      matching/greedy_iterative.h \
+      matching/greedy_b_matching.h \
+      matching/gpa/path.h \
+      matching/gpa/path_set.h \
+      matching/gpa/gpa.h \
+      matching/gpa/weight_buckets.h \
+      matching/gpa/gpa_multi_seed.h \
+      matching/algorithm_factory.h \
+      matching/normalized_graph.h \
+      matching/upper_bounds.h \
+      matching/solution_io.h \
+      matching/solution_writer.h \
+      matching/matching_stream.h \
+      matching/portfolio.h \
+      matching/dynamic/k_matching_repair.h \
+      matching/dynamic/demand_window.h \
+      matching/components/connected_components.h \
+      matching/components/component_solver.h \
+      matching/coloring/misra_gries.h \
+      matching/coloring/k_edge_coloring.hpp
+
+CONFIG(release, debug|release) {
+  unix:!macx: LIBS += -L$$PWD/../Algora/AlgoraDyn/build/Release/ -lAlgoraDyn
+  unix:!macx: LIBS += -L$$PWD/../Algora/AlgoraCore/build/Release/ -lAlgoraCore
+}
+CONFIG(debug, debug|release) {
+  unix:!macx: LIBS += -L$$PWD/../Algora/AlgoraDyn/build/Debug/ -lAlgoraDyn
+  unix:!macx: LIBS += -L$$PWD/../Algora/AlgoraCore/build/Debug/ -lAlgoraCore
+}
+
+INCLUDEPATH += $$PWD/../Algora/AlgoraCore/src
+DEPENDPATH += $$PWD/../Algora/AlgoraCore/src
+unix:!macx: PRE_TARGETDEPS += $$PWD/../Algora/AlgoraCore/build/Debug/libAlgoraCore.a
+
+INCLUDEPATH += $$PWD/../Algora/AlgoraDyn/src
+DEPENDPATH += $$PWD/../Algora/AlgoraDyn/src
+unix:!macx: PRE_TARGETDEPS += $$PWD/../Algora/AlgoraDyn/build/Debug/libAlgoraDyn.a
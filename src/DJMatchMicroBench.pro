@@ -0,0 +1,44 @@
+########################################################################
+# Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer         #
+#                                                                      #
+# This file is part of DJMatch and licensed under GPLv3.               #
+########################################################################
+
+QT =
+
+CONFIG += c++17 c++1z
+
+TARGET = DJMatchPrefetchScanBench
+CONFIG -= app_bundle
+
+TEMPLATE = app
+OBJECTS_DIR = $$TARGET-obj
+
+QMAKE_CXXFLAGS_APP =
+
+QMAKE_CXXFLAGS_DEBUG += -std=c++17 -O0
+
+QMAKE_CXXFLAGS_RELEASE -= -O3 -O2 -O1
+QMAKE_CXXFLAGS_RELEASE += -std=c++17 -DNDEBUG
+QMAKE_LFLAGS_RELEASE += -O3
+
+general {
+  QMAKE_CXXFLAGS_RELEASE += -O2 -march=x86-64
+} else {
+  QMAKE_CXXFLAGS_RELEASE += -O3 -march=native -mtune=native
+}
+
+noprefetch {
+  DEFINES += DJM_PREFETCH_WINDOW=0
+}
+
+nophasetimers {
+  DEFINES += DJM_PHASE_TIMERS=0
+}
+
+SOURCES += microbench/prefetch_scan_bench.cpp
+
+HEADERS += tools/chronotimer.h \
+      tools/perf_counters.h \
+      tools/trace.h \
+      matching/prefetch_scan.h
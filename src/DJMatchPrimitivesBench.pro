@@ -0,0 +1,88 @@
+########################################################################
+# Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer         #
+#                                                                      #
+# This file is part of DJMatch and licensed under GPLv3.               #
+########################################################################
+
+QT =
+
+CONFIG += c++17 c++1z thread
+
+TARGET = DJMatchPrimitivesBench
+CONFIG -= app_bundle
+
+TEMPLATE = app
+OBJECTS_DIR = $$TARGET-obj
+
+QMAKE_CXXFLAGS_APP =
+QMAKE_CXXFLAGS_STATIC_LIB = # remove -fPIC
+
+QMAKE_CXXFLAGS_DEBUG += -std=c++17 -O0
+QMAKE_LFLAGS_DEBUG +=
+
+QMAKE_CXXFLAGS_RELEASE -= -O3 -O2 -O1
+QMAKE_CXXFLAGS_RELEASE += -std=c++17 -DNDEBUG -flto
+QMAKE_LFLAGS_RELEASE += -flto -O3
+
+custom-ar {
+  QMAKE_AR += rcs
+} else {
+  QMAKE_AR -= cqs
+  QMAKE_AR -= cq
+  QMAKE_AR += rcs
+}
+
+general {
+  QMAKE_CXXFLAGS_RELEASE += -O2 -march=x86-64
+} else {
+  QMAKE_CXXFLAGS_RELEASE += -O3 -march=native -mtune=native
+}
+
+debugsymbols {
+	QMAKE_CXXFLAGS_RELEASE += -fno-omit-frame-pointer -g
+}
+
+noprefetch {
+  DEFINES += DJM_PREFETCH_WINDOW=0
+}
+
+nophasetimers {
+  DEFINES += DJM_PHASE_TIMERS=0
+}
+
+SOURCES += microbench/primitives_bench.cpp \
+      bench/generators.cpp \
+      matching/node_centered.cpp
+
+HEADERS += tools/chronotimer.h \
+      tools/parallel.h \
+      tools/perf_counters.h \
+      tools/trace.h \
+      bench/generators.h \
+      matching/matching_defs.h \
+      matching/matching_config.h \
+      matching/matching_algorithm.h \
+      matching/event_counters.h \
+      matching/prefetch_scan.h \
+      matching/solution_io.h \
+      matching/node_centered.h \
+      matching/gpa/path.h \
+      matching/gpa/path_set.h \
+      matching/coloring/k_edge_coloring.hpp
+
+CONFIG(release, debug|release) {
+  unix:!macx: LIBS += -L$$PWD/../Algora/AlgoraDyn/build/Release/ -lAlgoraDyn
+  unix:!macx: LIBS += -L$$PWD/../Algora/AlgoraCore/build/Release/ -lAlgoraCore
+}
+CONFIG(debug, debug|release) {
+  unix:!macx: LIBS += -L$$PWD/../Algora/AlgoraDyn/build/Debug/ -lAlgoraDyn
+  unix:!macx: LIBS += -L$$PWD/../Algora/AlgoraCore/build/Debug/ -lAlgoraCore
+}
+
+INCLUDEPATH += $$PWD/../Algora/AlgoraCore/src
+DEPENDPATH += $$PWD/../Algora/AlgoraCore/src
+unix:!macx: PRE_TARGETDEPS += $$PWD/../Algora/AlgoraCore/build/Debug/libAlgoraCore.a
+
+INCLUDEPATH += $$PWD/../Algora/AlgoraDyn/src
+DEPENDPATH += $$PWD/../Algora/AlgoraDyn/src
+unix:!macx: PRE_TARGETDEPS += $$PWD/../Algora/AlgoraDyn/build/Debug/libAlgoraDyn.a
@@ -0,0 +1,44 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+
+#include "bench/generators.h"
+
+struct BenchConfig {
+    std::vector<instance_type> generators;
+    unsigned min_log_n{10};
+    unsigned max_log_n{14};
+    // log_m = log_n + log_edge_factor
+    unsigned log_edge_factor{3};
+    double weight_mean{8192.0};
+    unsigned long seed{1};
+
+    std::vector<unsigned> bs;
+    unsigned warmup{1};
+    unsigned repetitions{5};
+
+    // only algorithms whose short name contains filter, empty = all
+    std::string filter = "";
+    // JSON result file, empty = stdout
+    std::string output = "";
+    // results CSV file (as written by DJMatch), one row per timed run, empty = none
+    std::string results_output = "";
+
+    // JSON results of an earlier run to compare against, empty = none
+    std::string baseline = "";
+    // tolerated relative slowdown and weight change against the baseline
+    double max_slowdown{0.05};
+    double max_weight_change{0.0};
+
+    // Pareto mode: report the frontier of weight versus time of all
+    // algorithm variants per instance and b
+    bool pareto{false};
+    // l of the GPA-ROMA variants in Pareto mode
+    std::vector<int> pareto_ls;
+};
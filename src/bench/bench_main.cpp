@@ -0,0 +1,502 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+// Benchmark suite: generates synthetic instances of increasing size,
+// runs every variant of every matching algorithm on them for several b,
+// and writes the median, minimum and standard deviation of running time,
+// weight and peak resident set size over all repetitions as JSON.
+// With --baseline, it reruns the instances, b and algorithms of an earlier
+// JSON result instead and fails if an algorithm got significantly slower
+// or its weight changed.
+// With --pareto, it also sweeps GPA-ROMA over several l and reports the
+// variants on the Pareto frontier of weight versus time per instance and
+// b, with their weight relative to an upper bound on the optimum.
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "djmatch_info.h"
+#include "results_csv.h"
+#include "tools/chronotimer.h"
+#include "tools/memory_usage.h"
+#include "bench/bench_config.h"
+#include "bench/bench_statistics.h"
+#include "bench/generators.h"
+#include "bench/parse_bench_parameters.h"
+#include "bench/pareto.h"
+#include "bench/regression.h"
+#include "matching/algorithm_factory.h"
+#include "matching/upper_bounds.h"
+#include "matching/gpa/gpa.h"
+#include "graph.incidencelist/incidencelistgraph.h"
+#include "property/fastpropertymap.h"
+
+// exit code if the comparison with the baseline found a regression
+constexpr int REGRESSION_EXIT_CODE = 2;
+
+std::string json_string(const std::string &text) {
+    std::string quoted = "\"";
+    for (auto c : text) {
+        if (c == '"' || c == '\\') {
+            quoted.push_back('\\');
+        }
+        quoted.push_back(c);
+    }
+    return quoted + "\"";
+}
+
+std::string json_summary(const std::vector<double> &samples) {
+    const auto summary = summarize(samples);
+    std::ostringstream out;
+    out << std::setprecision(9) << "{\"median\": " << summary.median << ", \"min\": " << summary.min
+        << ", \"stddev\": " << summary.stddev << ", \"samples\": [";
+    for (auto i = 0UL; i < samples.size(); i++) {
+        out << (i > 0 ? ", " : "") << samples[i];
+    }
+    out << "]}";
+    return out.str();
+}
+
+// a graph with vertex ids 0, ..., 2^log_n - 1 and one arc per generated arc
+struct bench_instance {
+    Algora::IncidenceListGraph graph;
+    Algora::FastPropertyMap<EdgeWeight> weights{0};
+};
+
+void build_instance(const std::vector<generated_arc> &arcs, unsigned long n, bench_instance &instance) {
+    std::vector<Algora::Vertex*> vertex_of_id(n);
+    for (auto id = 0UL; id < n; id++) {
+        vertex_of_id[id] = instance.graph.addVertex();
+    }
+    instance.weights.resetAll(arcs.size());
+    for (const auto &arc : arcs) {
+        auto *a = instance.graph.addArc(vertex_of_id[arc.tail], vertex_of_id[arc.head]);
+        instance.weights[a] = arc.weight;
+    }
+}
+
+void generate(const instance_params &params, unsigned threads, bench_instance &instance, std::ostream &log) {
+    ChronoTimer t;
+    {
+        const auto arcs = generate_instance(params, threads);
+        build_instance(arcs, 1UL << params.log_n, instance);
+    }
+    log << instance_name(params) << ": " << instance.graph.getSize() << " vertices, "
+        << instance.graph.getNumArcs(true) << " arcs, generated in "
+        << std::fixed << std::setprecision(3) << t.elapsed() << "s\n";
+}
+
+struct run_samples {
+    bool prepared{true};
+    std::vector<double> times;
+    std::vector<double> weights;
+    std::vector<double> peak_rss;
+};
+
+// warm-up runs and timed runs of algo for config.b, every timed run is
+// also appended to csv if given
+run_samples run_repetitions(matching_algorithm &algo, const BenchConfig &bench_config,
+        const MatchingConfig &config, std::ostream *csv) {
+    run_samples samples;
+    for (auto r = 0U; r < bench_config.warmup + bench_config.repetitions; r++) {
+        const auto timed = r >= bench_config.warmup;
+        reset_peak_rss();
+        algorithm_result result;
+        const auto rss_before = current_rss_kb();
+        const auto allocations_before = process_allocations();
+        algo.set_num_matchings(config.b);
+        if (!algo.prepare()) {
+            samples.prepared = false;
+            break;
+        }
+        ChronoTimer run_t;
+        ThreadCpuTimer cpu_t;
+        algo.run();
+        result.time = run_t.elapsed();
+        result.cpu_time = cpu_t.elapsed();
+        if (timed) {
+            const auto peak_rss = peak_rss_kb();
+            result.prepared = true;
+            result.weight = algo.deliver();
+            result.allocations = process_allocations() - allocations_before;
+            result.rss_delta_kb = std::max(0L, peak_rss - rss_before);
+            samples.times.push_back(result.time);
+            samples.weights.push_back(result.weight);
+            samples.peak_rss.push_back(peak_rss);
+            if (csv != nullptr) {
+                write_result_row(*csv, config, config.seed, algo.getThreshold(), algo.getShortName(), result);
+            }
+        }
+    }
+    return samples;
+}
+
+void write_json_result(std::ostream &json, bool &first_result, const instance_params &params,
+        const bench_instance &instance, unsigned b, const matching_algorithm &algo, const run_samples &samples) {
+    json << (first_result ? "\n" : ",\n")
+        << "    {\"instance\": " << json_string(instance_name(params))
+        << ", \"generator\": " << json_string(instance_type_name(params.type))
+        << ", \"log_n\": " << params.log_n
+        << ", \"log_m\": " << params.log_m
+        << ", \"weight_mean\": " << params.weight_mean
+        << ", \"n\": " << instance.graph.getSize()
+        << ", \"m\": " << instance.graph.getNumArcs(true)
+        << ", \"b\": " << b
+        << ", \"algorithm\": " << json_string(algo.getName())
+        << ", \"short_name\": " << json_string(algo.getShortName())
+        << ",\n     \"time_s\": " << json_summary(samples.times)
+        << ",\n     \"weight\": " << json_summary(samples.weights)
+        << ",\n     \"peak_rss_kb\": " << json_summary(samples.peak_rss) << "}";
+    json.flush();
+    first_result = false;
+}
+
+void set_up(matching_algorithm &algo, bench_instance &instance) {
+    algo.set_max_vertex_id(instance.graph.getSize());
+    algo.setGraph(&instance.graph);
+    algo.setWeights(&instance.weights);
+}
+
+bool selected(const BenchConfig &bench_config, const std::string &short_name) {
+    return bench_config.filter.empty() || short_name.find(bench_config.filter) != std::string::npos;
+}
+
+// all generators, sizes, algorithms and b of bench_config
+void run_matrix(const BenchConfig &bench_config, MatchingConfig &config, std::ostream &json,
+        std::ostream &log, std::ostream *csv) {
+    bool first_result = true;
+    for (auto type : bench_config.generators) {
+        for (auto log_n = bench_config.min_log_n; log_n <= bench_config.max_log_n; log_n++) {
+            instance_params params;
+            params.type = type;
+            params.log_n = log_n;
+            params.log_m = log_n + bench_config.log_edge_factor;
+            params.weight_mean = bench_config.weight_mean;
+            params.seed = bench_config.seed;
+            config.graph_filename = instance_name(params);
+
+            bench_instance instance;
+            generate(params, config.threads, instance, log);
+
+            algorithm_list algos;
+            create_all_algorithms(config, algos);
+            for (auto &algo : algos) {
+                if (!selected(bench_config, algo->getShortName())) {
+                    continue;
+                }
+                set_up(*algo, instance);
+
+                for (auto b : bench_config.bs) {
+                    config.b = b;
+                    const auto samples = run_repetitions(*algo, bench_config, config, csv);
+                    if (!samples.prepared) {
+                        log << "  " << algo->getName() << " b=" << b << ": prepare failed\n";
+                        continue;
+                    }
+                    const auto time = summarize(samples.times);
+                    log << "  " << std::left << std::setw(40) << algo->getName() << std::right
+                        << " b=" << std::setw(3) << b << " median " << std::setprecision(6) << time.median << "s\n";
+                    write_json_result(json, first_result, params, instance, b, *algo, samples);
+                }
+            }
+        }
+    }
+}
+
+// all variants of create_all_algorithms, but GPA-ROMA with every l of
+// the sweep instead of config.l
+void create_sweep_algorithms(const BenchConfig &bench_config, MatchingConfig &config, algorithm_list &algos) {
+    const auto l = config.l;
+    config.l = 0;
+    create_all_algorithms(config, algos);
+    config.l = l;
+    for (auto sweep_l : bench_config.pareto_ls) {
+        algos.emplace_back(new gpa(config, false, false, sweep_l));
+    }
+}
+
+void print_frontier(std::ostream &log, const std::vector<pareto_point> &points, EdgeWeight bound) {
+    log << "  | " << std::left << std::setw(40) << "algorithm" << std::right
+        << " | " << std::setw(12) << "time (s)"
+        << " | " << std::setw(14) << "weight"
+        << " | " << std::setw(8) << "of bound" << " |\n";
+    for (const auto &p : points) {
+        if (!p.pareto) {
+            continue;
+        }
+        log << "  | " << std::left << std::setw(40) << p.algorithm << std::right
+            << " | " << std::setw(12) << std::fixed << std::setprecision(6) << p.time
+            << " | " << std::setw(14) << std::setprecision(0) << p.weight
+            << " | " << std::setw(7) << std::setprecision(2)
+            << (bound > 0 ? 100.0 * p.weight / bound : 0.0) << "% |\n";
+    }
+}
+
+void write_json_frontier(std::ostream &json, bool &first_result, const instance_params &params,
+        const bench_instance &instance, unsigned b, EdgeWeight top_b_bound, EdgeWeight bound,
+        const std::vector<pareto_point> &points) {
+    json << (first_result ? "\n" : ",\n")
+        << "    {\"instance\": " << json_string(instance_name(params))
+        << ", \"generator\": " << json_string(instance_type_name(params.type))
+        << ", \"log_n\": " << params.log_n
+        << ", \"log_m\": " << params.log_m
+        << ", \"weight_mean\": " << params.weight_mean
+        << ", \"n\": " << instance.graph.getSize()
+        << ", \"m\": " << instance.graph.getNumArcs(true)
+        << ", \"b\": " << b
+        << ", \"top_b_bound\": " << top_b_bound
+        << ", \"fractional_bound\": " << bound
+        << ",\n     \"points\": [";
+    for (auto i = 0UL; i < points.size(); i++) {
+        const auto &p = points[i];
+        json << (i > 0 ? "," : "") << "\n      {\"algorithm\": " << json_string(p.algorithm)
+            << ", \"short_name\": " << json_string(p.short_name)
+            << ", \"time_s\": " << std::setprecision(9) << p.time
+            << ", \"weight\": " << p.weight
+            << ", \"bound_ratio\": " << (bound > 0 ? p.weight / bound : 0.0)
+            << ", \"pareto\": " << (p.pareto ? "true" : "false") << "}";
+    }
+    json << "]}";
+    json.flush();
+    first_result = false;
+}
+
+// all generators, sizes, algorithm variants and b of bench_config; only
+// the medians of the variants on the Pareto frontier are printed
+void run_pareto(const BenchConfig &bench_config, MatchingConfig &config, std::ostream &json,
+        std::ostream &log, std::ostream *csv) {
+    bool first_result = true;
+    for (auto type : bench_config.generators) {
+        for (auto log_n = bench_config.min_log_n; log_n <= bench_config.max_log_n; log_n++) {
+            instance_params params;
+            params.type = type;
+            params.log_n = log_n;
+            params.log_m = log_n + bench_config.log_edge_factor;
+            params.weight_mean = bench_config.weight_mean;
+            params.seed = bench_config.seed;
+            config.graph_filename = instance_name(params);
+
+            bench_instance instance;
+            generate(params, config.threads, instance, log);
+            ChronoTimer bound_t;
+            upper_bounds bounds(&instance.graph, instance.weights, instance.graph.getSize(), config.threads);
+            log << "  upper bounds prepared in " << std::fixed << std::setprecision(3) << bound_t.elapsed() << "s\n";
+
+            algorithm_list algos;
+            create_sweep_algorithms(bench_config, config, algos);
+            std::vector<std::vector<pareto_point>> points(bench_config.bs.size());
+            for (auto &algo : algos) {
+                if (!selected(bench_config, algo->getShortName())) {
+                    continue;
+                }
+                set_up(*algo, instance);
+
+                for (auto bi = 0UL; bi < bench_config.bs.size(); bi++) {
+                    config.b = bench_config.bs[bi];
+                    const auto samples = run_repetitions(*algo, bench_config, config, csv);
+                    if (!samples.prepared) {
+                        log << "  " << algo->getName() << " b=" << config.b << ": prepare failed\n";
+                        continue;
+                    }
+                    points[bi].push_back({algo->getName(), algo->getShortName(),
+                            summarize(samples.times).median, summarize(samples.weights).median, false});
+                }
+            }
+
+            for (auto bi = 0UL; bi < bench_config.bs.size(); bi++) {
+                const auto b = bench_config.bs[bi];
+                const auto top_b_bound = bounds.top_b(b);
+                const auto bound = bounds.fractional(b);
+                mark_pareto_frontier(points[bi]);
+                const auto on_frontier = std::count_if(points[bi].begin(), points[bi].end(),
+                        [] (const pareto_point &p) { return p.pareto; });
+                log << instance_name(params) << ", b=" << b << ": " << on_frontier << " of "
+                    << points[bi].size() << " variants on the frontier, upper bounds " << top_b_bound << " (top-b), "
+                    << bound << " (fractional)\n";
+                print_frontier(log, points[bi], bound);
+                write_json_frontier(json, first_result, params, instance, b, top_b_bound, bound, points[bi]);
+            }
+        }
+    }
+}
+
+std::string relative_change(const difference_interval &interval) {
+    std::ostringstream out;
+    const auto base = interval.baseline_mean != 0.0 ? std::abs(interval.baseline_mean) : 1.0;
+    out << std::showpos << std::fixed << std::setprecision(1)
+        << 100.0 * interval.difference() / base << "% ["
+        << 100.0 * interval.low / base << "%, " << 100.0 * interval.high / base << "%]";
+    return out.str();
+}
+
+// reruns all results of the baseline, returns the number of regressions
+unsigned run_baseline(const BenchConfig &bench_config, MatchingConfig &config, const baseline_run &baseline,
+        std::ostream &json, std::ostream &log, std::ostream *csv) {
+    regression_limits limits;
+    limits.max_slowdown = bench_config.max_slowdown;
+    limits.max_weight_change = bench_config.max_weight_change;
+
+    log << "Comparing against baseline " << bench_config.baseline << " (revision "
+        << baseline.git_revision << "), " << 100 * limits.confidence << "% confidence intervals of the mean change:\n";
+
+    bool first_result = true;
+    unsigned regressions = 0;
+    unsigned compared = 0;
+    std::vector<char> done(baseline.entries.size(), false);
+    for (auto i = 0UL; i < baseline.entries.size(); i++) {
+        if (done[i]) {
+            continue;
+        }
+        // all results on the same instance
+        const auto &params = baseline.entries[i].params;
+        config.graph_filename = instance_name(params);
+        config.seed = params.seed;
+        bench_instance instance;
+        generate(params, config.threads, instance, log);
+        algorithm_list algos;
+        create_all_algorithms(config, algos);
+
+        for (auto j = i; j < baseline.entries.size(); j++) {
+            const auto &entry = baseline.entries[j];
+            if (done[j] || entry.instance != baseline.entries[i].instance) {
+                continue;
+            }
+            done[j] = true;
+            if (!selected(bench_config, entry.algorithm)) {
+                continue;
+            }
+            auto algo = std::find_if(algos.begin(), algos.end(), [&entry] (const std::unique_ptr<matching_algorithm> &a) {
+                return a->getShortName() == entry.algorithm;
+            });
+            compared++;
+            config.b = entry.b;
+            run_samples samples;
+            if (algo != algos.end()) {
+                set_up(**algo, instance);
+                samples = run_repetitions(**algo, bench_config, config, csv);
+            }
+            if (!samples.prepared) {
+                samples.times.clear();
+            }
+            const auto result = compare_to_baseline(entry, samples.times, samples.weights, limits);
+            if (result.regression()) {
+                regressions++;
+            }
+
+            log << "  " << std::left << std::setw(40) << entry.algorithm << std::right
+                << " b=" << std::setw(3) << entry.b;
+            if (result.verdict == comparison_verdict::MISSING) {
+                log << " not available or failed to prepare";
+            } else {
+                log << " time " << std::setprecision(6) << result.time.baseline_mean << "s -> "
+                    << result.time.current_mean << "s " << relative_change(result.time)
+                    << ", weight " << relative_change(result.weight);
+                write_json_result(json, first_result, params, instance, entry.b, **algo, samples);
+            }
+            log << "  " << verdict_name(result.verdict) << "\n";
+        }
+    }
+    log << regressions << " of " << compared << " results regressed.\n";
+    return regressions;
+}
+
+int main(int argc, char **argv) {
+    BenchConfig bench_config;
+    MatchingConfig config;
+    bool do_return;
+    auto code = parse_bench_parameters(argc, argv, bench_config, config, do_return);
+    if (code > 0) {
+        return code;
+    } else if (do_return) {
+        return 0;
+    }
+
+    baseline_run baseline;
+    if (!bench_config.baseline.empty()) {
+        std::string error;
+        if (!read_baseline(bench_config.baseline, baseline, error)) {
+            std::cerr << "Error! " << error << "\n";
+            return 1;
+        }
+        // the same algorithm variants as in the baseline
+        if (baseline.l >= 0) {
+            config.l = baseline.l;
+            config.roma = true;
+        }
+        if (!baseline.thresholds.empty()) {
+            config.global_thresholds = baseline.thresholds;
+        }
+    }
+
+    std::ofstream output_file;
+    if (!bench_config.output.empty()) {
+        output_file.open(bench_config.output);
+        if (!output_file.is_open()) {
+            std::cerr << "Error! Could not open file " << bench_config.output << "\n";
+            return 1;
+        }
+    }
+    std::ostream &json = bench_config.output.empty() ? std::cout : output_file;
+    // progress goes to stderr if the results go to stdout
+    std::ostream &log = bench_config.output.empty() ? std::cerr : std::cout;
+
+    std::ofstream csv_file;
+    if (!bench_config.results_output.empty()) {
+        std::ifstream existing(bench_config.results_output);
+        const bool nfile = !existing.good();
+        existing.close();
+        csv_file.open(bench_config.results_output, std::ios::app | std::ios::out);
+        if (!csv_file.is_open()) {
+            std::cerr << "Error! Could not open file " << bench_config.results_output << "\n";
+            return 1;
+        }
+        if (nfile) {
+            csv_file << RESULTS_CSV_HEADER;
+        }
+    }
+    std::ostream *csv = csv_file.is_open() ? &csv_file : nullptr;
+
+    json << "{\n"
+        << "  \"git_revision\": " << json_string(DJMatchInfo::GIT_REVISION) << ",\n"
+        << "  \"git_date\": " << json_string(DJMatchInfo::GIT_DATE) << ",\n"
+        << "  \"warmup\": " << bench_config.warmup << ",\n"
+        << "  \"repetitions\": " << bench_config.repetitions << ",\n"
+        << "  \"seed\": " << (baseline.entries.empty() ? bench_config.seed : baseline.entries.front().params.seed) << ",\n"
+        << "  \"l\": " << (config.roma ? config.l : -1) << ",\n"
+        << "  \"thresholds\": [";
+    for (auto i = 0UL; i < config.global_thresholds.size(); i++) {
+        json << (i > 0 ? ", " : "") << config.global_thresholds[i];
+    }
+    json << "],\n";
+    if (bench_config.pareto) {
+        json << "  \"pareto_l\": [";
+        for (auto i = 0UL; i < bench_config.pareto_ls.size(); i++) {
+            json << (i > 0 ? ", " : "") << bench_config.pareto_ls[i];
+        }
+        json << "],\n"
+            << "  \"frontiers\": [";
+    } else {
+        json << "  \"results\": [";
+    }
+
+    unsigned regressions = 0;
+    if (bench_config.pareto) {
+        run_pareto(bench_config, config, json, log, csv);
+    } else if (bench_config.baseline.empty()) {
+        run_matrix(bench_config, config, json, log, csv);
+    } else {
+        regressions = run_baseline(bench_config, config, baseline, json, log, csv);
+    }
+    json << "\n  ]\n}\n";
+    return regressions > 0 ? REGRESSION_EXIT_CODE : 0;
+}
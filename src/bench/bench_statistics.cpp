@@ -0,0 +1,135 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "bench/bench_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+sample_summary summarize(std::vector<double> samples) {
+    sample_summary summary;
+    if (samples.empty()) {
+        return summary;
+    }
+    std::sort(samples.begin(), samples.end());
+    const auto size = samples.size();
+    summary.min = samples.front();
+    summary.median = size % 2 != 0 ? samples[size / 2] : (samples[size / 2 - 1] + samples[size / 2]) / 2.0;
+    double mean = 0.0;
+    for (auto s : samples) {
+        mean += s;
+    }
+    mean /= size;
+    double variance = 0.0;
+    for (auto s : samples) {
+        variance += (s - mean) * (s - mean);
+    }
+    summary.stddev = std::sqrt(variance / size);
+    return summary;
+}
+
+namespace {
+
+struct mean_variance {
+    double mean{0.0};
+    // sample variance, 0 for fewer than two values
+    double variance{0.0};
+    double size{0.0};
+};
+
+mean_variance moments(const std::vector<double> &samples) {
+    mean_variance m;
+    m.size = samples.size();
+    if (samples.empty()) {
+        return m;
+    }
+    for (auto s : samples) {
+        m.mean += s;
+    }
+    m.mean /= m.size;
+    if (samples.size() > 1) {
+        for (auto s : samples) {
+            m.variance += (s - m.mean) * (s - m.mean);
+        }
+        m.variance /= m.size - 1;
+    }
+    return m;
+}
+
+// quantile of the standard normal distribution, after Acklam
+double normal_quantile(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+        1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+        6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+        -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+        3.754408661907416e+00};
+    const double low = 0.02425;
+    if (p < low) {
+        const double q = std::sqrt(-2 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+            / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    if (p > 1 - low) {
+        return -normal_quantile(1 - p);
+    }
+    const double q = p - 0.5;
+    const double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+        / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+// quantile of Student's t distribution with df degrees of freedom,
+// Cornish-Fisher expansion around the normal quantile; exact for df 1, 2
+double t_quantile(double p, double df) {
+    const double pi = 3.14159265358979323846;
+    if (df <= 1.0) {
+        return std::tan(pi * (p - 0.5));
+    }
+    if (df <= 2.0) {
+        const double alpha = 4 * p * (1 - p);
+        return 2 * (p - 0.5) * std::sqrt(2 / alpha);
+    }
+    const double z = normal_quantile(p);
+    const double z3 = z * z * z;
+    const double z5 = z3 * z * z;
+    const double z7 = z5 * z * z;
+    return z + (z3 + z) / (4 * df) + (5 * z5 + 16 * z3 + 3 * z) / (96 * df * df)
+        + (3 * z7 + 19 * z5 + 17 * z3 - 15 * z) / (384 * df * df * df);
+}
+
+}
+
+difference_interval mean_difference(const std::vector<double> &baseline,
+        const std::vector<double> &current, double confidence) {
+    difference_interval interval;
+    const auto base = moments(baseline);
+    const auto cur = moments(current);
+    interval.baseline_mean = base.mean;
+    interval.current_mean = cur.mean;
+
+    const double base_var = base.size > 0 ? base.variance / base.size : 0.0;
+    const double cur_var = cur.size > 0 ? cur.variance / cur.size : 0.0;
+    const double se2 = base_var + cur_var;
+    double half_width = 0.0;
+    if (se2 > 0.0) {
+        // Welch-Satterthwaite degrees of freedom
+        double denominator = 0.0;
+        if (base.size > 1) {
+            denominator += base_var * base_var / (base.size - 1);
+        }
+        if (cur.size > 1) {
+            denominator += cur_var * cur_var / (cur.size - 1);
+        }
+        const double df = denominator > 0.0 ? se2 * se2 / denominator : 1.0;
+        half_width = t_quantile(0.5 + confidence / 2, df) * std::sqrt(se2);
+    }
+    interval.low = interval.difference() - half_width;
+    interval.high = interval.difference() + half_width;
+    return interval;
+}
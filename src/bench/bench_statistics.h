@@ -0,0 +1,39 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <vector>
+
+struct sample_summary {
+    double median{0.0};
+    double min{0.0};
+    // population standard deviation
+    double stddev{0.0};
+};
+
+sample_summary summarize(std::vector<double> samples);
+
+// two-sided confidence interval for the difference of the means of two
+// samples, mean(current) - mean(baseline), after Welch; with fewer than
+// two values in a sample, its variance is taken as 0
+struct difference_interval {
+    double baseline_mean{0.0};
+    double current_mean{0.0};
+    double low{0.0};
+    double high{0.0};
+
+    double difference() const noexcept {
+        return current_mean - baseline_mean;
+    }
+
+    // the interval does not contain 0
+    bool significant() const noexcept {
+        return low > 0.0 || high < 0.0;
+    }
+};
+
+difference_interval mean_difference(const std::vector<double> &baseline,
+        const std::vector<double> &current, double confidence = 0.95);
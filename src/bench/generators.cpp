@@ -0,0 +1,247 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "bench/generators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "tools/parallel.h"
+
+namespace {
+
+const auto CHUNK_SIZE = 1UL << 16;
+const unsigned RACK_SIZE = 32;
+const double INTRA_RACK_SHARE = 0.6;
+const double ZIPF_EXPONENT = 1.2;
+const double PARETO_SHAPE = 1.5;
+
+using rng_t = std::mt19937_64;
+
+// independent stream per chunk, so that the result doesn't depend on
+// the number of threads
+rng_t chunk_rng(unsigned long seed, unsigned long chunk) {
+    std::seed_seq seq{seed, chunk, 0x646a6d61UL};
+    return rng_t(seq);
+}
+
+struct rmat_probabilities {
+    double a, b, c;
+};
+
+rmat_probabilities rmat_parameters(instance_type type) {
+    switch (type) {
+        case instance_type::RMAT_B:
+            return {0.55, 0.15, 0.15};
+        case instance_type::RMAT_G:
+            return {0.45, 0.15, 0.15};
+        default:
+            return {0.25, 0.25, 0.25};
+    }
+}
+
+EdgeWeight exponential_weight(rng_t &rng, double mean) {
+    std::exponential_distribution<double> dist(1.0 / mean);
+    return static_cast<EdgeWeight>(std::ceil(dist(rng)));
+}
+
+EdgeWeight pareto_weight(rng_t &rng, double mean) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const auto scale = mean * (PARETO_SHAPE - 1.0) / PARETO_SHAPE;
+    const auto u = 1.0 - uniform(rng);
+    return static_cast<EdgeWeight>(std::ceil(scale / std::pow(u, 1.0 / PARETO_SHAPE)));
+}
+
+// rank in [0, n) with P(rank = r) roughly proportional to (r + 1)^-s,
+// by inverting the continuous approximation of the CDF
+unsigned long zipf_rank(rng_t &rng, unsigned long n) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const auto e = 1.0 - ZIPF_EXPONENT;
+    const auto x = std::pow((std::pow(n + 1.0, e) - 1.0) * uniform(rng) + 1.0, 1.0 / e);
+    return std::min(n - 1, static_cast<unsigned long>(x) - 1);
+}
+
+generated_arc rmat_sample(rng_t &rng, unsigned log_n, const rmat_probabilities &p, double weight_mean) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    unsigned long u = 0, v = 0;
+    for (auto level = 0U; level < log_n; level++) {
+        const auto r = uniform(rng);
+        u <<= 1;
+        v <<= 1;
+        if (r < p.a) {
+            // upper left
+        } else if (r < p.a + p.b) {
+            v |= 1;
+        } else if (r < p.a + p.b + p.c) {
+            u |= 1;
+        } else {
+            u |= 1;
+            v |= 1;
+        }
+    }
+    return {u, v, exponential_weight(rng, weight_mean)};
+}
+
+generated_arc erdos_renyi_sample(rng_t &rng, unsigned long n, double weight_mean) {
+    std::uniform_int_distribution<unsigned long> vertex(0, n - 1);
+    const auto u = vertex(rng);
+    const auto v = vertex(rng);
+    return {u, v, exponential_weight(rng, weight_mean)};
+}
+
+// hot hosts are spread over the racks by a fixed permutation
+generated_arc datacenter_sample(rng_t &rng, const std::vector<unsigned long> &host_of_rank,
+        double weight_mean) {
+    const auto n = host_of_rank.size();
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const auto u = host_of_rank[zipf_rank(rng, n)];
+    unsigned long v;
+    if (n > RACK_SIZE && uniform(rng) >= INTRA_RACK_SHARE) {
+        v = host_of_rank[zipf_rank(rng, n)];
+    } else {
+        const auto rack_begin = u - u % RACK_SIZE;
+        const auto rack_size = std::min<unsigned long>(RACK_SIZE, n - rack_begin);
+        std::uniform_int_distribution<unsigned long> host(0, rack_size - 1);
+        v = rack_begin + host(rng);
+    }
+    return {u, v, pareto_weight(rng, weight_mean)};
+}
+
+std::vector<generated_arc> barabasi_albert(unsigned long n, unsigned long m, unsigned long seed,
+        double weight_mean) {
+    auto rng = chunk_rng(seed, 0);
+    const auto per_vertex = std::max(1UL, m / n);
+    std::vector<generated_arc> arcs;
+    arcs.reserve(n * per_vertex);
+    // each vertex once per incident arc, for sampling by degree
+    std::vector<unsigned long> endpoints;
+    endpoints.reserve(2 * n * per_vertex);
+    for (auto v = 1UL; v < n; v++) {
+        const auto degree = std::min(v, per_vertex);
+        for (auto i = 0UL; i < degree; i++) {
+            unsigned long u = 0;
+            if (!endpoints.empty()) {
+                std::uniform_int_distribution<std::size_t> pick(0, endpoints.size() - 1);
+                u = endpoints[pick(rng)];
+            }
+            arcs.push_back({u, v, exponential_weight(rng, weight_mean)});
+        }
+        for (auto i = arcs.size() - degree; i < arcs.size(); i++) {
+            endpoints.push_back(arcs[i].tail);
+            endpoints.push_back(v);
+        }
+    }
+    return arcs;
+}
+
+// drops self-loops, orients each arc from the smaller to the larger id
+// and sums up the weights of repeated arcs
+void merge_arcs(std::vector<generated_arc> &arcs) {
+    for (auto &arc : arcs) {
+        if (arc.tail > arc.head) {
+            std::swap(arc.tail, arc.head);
+        }
+    }
+    arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [] (const generated_arc &arc) {
+        return arc.tail == arc.head;
+    }), arcs.end());
+    std::sort(arcs.begin(), arcs.end(), [] (const generated_arc &lop, const generated_arc &rop) {
+        return lop.tail < rop.tail || (lop.tail == rop.tail && lop.head < rop.head);
+    });
+    auto out = arcs.begin();
+    for (auto it = arcs.begin(); it != arcs.end(); ++it) {
+        if (out != arcs.begin() && (out - 1)->tail == it->tail && (out - 1)->head == it->head) {
+            (out - 1)->weight += it->weight;
+        } else {
+            *out++ = *it;
+        }
+    }
+    arcs.erase(out, arcs.end());
+}
+
+}
+
+std::vector<instance_type> all_instance_types() {
+    return { instance_type::RMAT_B, instance_type::RMAT_G, instance_type::RMAT_ER,
+        instance_type::ERDOS_RENYI, instance_type::BARABASI_ALBERT, instance_type::DATACENTER };
+}
+
+std::string instance_type_name(instance_type type) {
+    switch (type) {
+        case instance_type::RMAT_B:
+            return "rmat-b";
+        case instance_type::RMAT_G:
+            return "rmat-g";
+        case instance_type::RMAT_ER:
+            return "rmat-er";
+        case instance_type::ERDOS_RENYI:
+            return "er";
+        case instance_type::BARABASI_ALBERT:
+            return "ba";
+        default:
+            return "datacenter";
+    }
+}
+
+bool parse_instance_type(const std::string &name, instance_type &type) {
+    for (auto t : all_instance_types()) {
+        if (instance_type_name(t) == name) {
+            type = t;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string instance_name(const instance_params &params) {
+    auto name = instance_type_name(params.type);
+    std::replace(name.begin(), name.end(), '-', '_');
+    return name + "_" + std::to_string(params.log_n) + "_" + std::to_string(params.log_m)
+        + (params.type == instance_type::DATACENTER ? "_pareto" : "_exp");
+}
+
+std::vector<generated_arc> generate_instance(const instance_params &params, unsigned threads) {
+    const auto n = 1UL << params.log_n;
+    const auto m = 1UL << params.log_m;
+    if (params.type == instance_type::BARABASI_ALBERT) {
+        auto arcs = barabasi_albert(n, m, params.seed, params.weight_mean);
+        merge_arcs(arcs);
+        return arcs;
+    }
+
+    std::vector<unsigned long> host_of_rank;
+    if (params.type == instance_type::DATACENTER) {
+        host_of_rank.resize(n);
+        for (auto i = 0UL; i < n; i++) {
+            host_of_rank[i] = i;
+        }
+        auto rng = chunk_rng(params.seed, ~0UL);
+        std::shuffle(host_of_rank.begin(), host_of_rank.end(), rng);
+    }
+    const auto rmat = rmat_parameters(params.type);
+
+    std::vector<generated_arc> arcs(m);
+    parallel_for((m + CHUNK_SIZE - 1) / CHUNK_SIZE, threads, [&] (std::size_t c) {
+        auto rng = chunk_rng(params.seed, c);
+        const auto end = std::min(m, (c + 1) * CHUNK_SIZE);
+        for (auto i = c * CHUNK_SIZE; i < end; i++) {
+            switch (params.type) {
+                case instance_type::ERDOS_RENYI:
+                    arcs[i] = erdos_renyi_sample(rng, n, params.weight_mean);
+                    break;
+                case instance_type::DATACENTER:
+                    arcs[i] = datacenter_sample(rng, host_of_rank, params.weight_mean);
+                    break;
+                default:
+                    arcs[i] = rmat_sample(rng, params.log_n, rmat, params.weight_mean);
+                    break;
+            }
+        }
+    });
+    merge_arcs(arcs);
+    return arcs;
+}
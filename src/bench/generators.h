@@ -0,0 +1,56 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+
+#include "matching/matching_defs.h"
+
+// Synthetic weighted instances for benchmarks.
+//  - rmat-b, rmat-g, rmat-er: R-MAT with (a, b, c, d) = (0.55, 0.15,
+//    0.15, 0.15), (0.45, 0.15, 0.15, 0.25) and (0.25, 0.25, 0.25, 0.25),
+//    respectively, as for examples/rmat_*_10_13_exp.graph,
+//  - er: Erdős–Rényi G(n, m),
+//  - ba: Barabási–Albert preferential attachment with m / n arcs per vertex,
+//  - datacenter: demand matrix of n hosts in racks of 32, where sources
+//    and most destinations follow a Zipf distribution over the hosts, 60%
+//    of the demand stays within the rack, and demands are Pareto
+//    distributed.
+// Except for datacenter, weights are exponentially distributed.
+// Instances have 2^log_n vertices and 2^log_m sampled arcs; self-loops
+// are dropped and the weights of repeated arcs are summed up, which
+// yields instances like the examples for log_n = 10, log_m = 13 and
+// weight_mean = 2^13.
+enum class instance_type { RMAT_B, RMAT_G, RMAT_ER, ERDOS_RENYI, BARABASI_ALBERT, DATACENTER };
+
+struct instance_params {
+    instance_type type{instance_type::RMAT_B};
+    unsigned log_n{10};
+    unsigned log_m{13};
+    double weight_mean{8192.0};
+    unsigned long seed{1};
+};
+
+// tail < head, sorted by tail, then by head
+struct generated_arc {
+    unsigned long tail;
+    unsigned long head;
+    EdgeWeight weight;
+};
+
+std::vector<instance_type> all_instance_types();
+
+std::string instance_type_name(instance_type type);
+
+bool parse_instance_type(const std::string &name, instance_type &type);
+
+// e.g., rmat_b_10_13_exp
+std::string instance_name(const instance_params &params);
+
+// samples are drawn in parallel on up to threads threads, the result
+// only depends on params
+std::vector<generated_arc> generate_instance(const instance_params &params, unsigned threads);
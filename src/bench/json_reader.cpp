@@ -0,0 +1,220 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "bench/json_reader.h"
+
+#include <cctype>
+#include <cstdlib>
+
+const json_value *json_value::get(const std::string &key) const {
+    if (type != kind::OBJECT) {
+        return nullptr;
+    }
+    for (const auto &member : object) {
+        if (member.first == key) {
+            return &member.second;
+        }
+    }
+    return nullptr;
+}
+
+double json_value::get_number(const std::string &key, double fallback) const {
+    auto *value = get(key);
+    return value != nullptr && value->type == kind::NUMBER ? value->number : fallback;
+}
+
+std::string json_value::get_string(const std::string &key, const std::string &fallback) const {
+    auto *value = get(key);
+    return value != nullptr && value->type == kind::STRING ? value->string : fallback;
+}
+
+namespace {
+
+class json_parser {
+    public:
+        json_parser(const std::string &text, std::string &error) : text(text), error(error) {}
+
+        bool parse_document(json_value &value) {
+            if (!parse_value(value, 0)) {
+                return false;
+            }
+            skip_whitespace();
+            if (pos != text.size()) {
+                return fail("unexpected trailing characters");
+            }
+            return true;
+        }
+
+    private:
+        // deeper documents are rejected instead of overflowing the stack
+        static constexpr unsigned max_depth = 64;
+
+        const std::string &text;
+        std::string &error;
+        std::string::size_type pos{0};
+
+        bool fail(const std::string &message) {
+            error = message + " at offset " + std::to_string(pos);
+            return false;
+        }
+
+        void skip_whitespace() {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+                pos++;
+            }
+        }
+
+        bool consume(char c) {
+            skip_whitespace();
+            if (pos < text.size() && text[pos] == c) {
+                pos++;
+                return true;
+            }
+            return false;
+        }
+
+        bool consume_literal(const char *literal) {
+            const std::string expected(literal);
+            if (text.compare(pos, expected.size(), expected) != 0) {
+                return fail("invalid literal");
+            }
+            pos += expected.size();
+            return true;
+        }
+
+        bool parse_value(json_value &value, unsigned depth) {
+            if (depth > max_depth) {
+                return fail("nesting too deep");
+            }
+            skip_whitespace();
+            if (pos >= text.size()) {
+                return fail("unexpected end of input");
+            }
+            switch (text[pos]) {
+                case '{':
+                    return parse_object(value, depth);
+                case '[':
+                    return parse_array(value, depth);
+                case '"':
+                    value.type = json_value::kind::STRING;
+                    return parse_string(value.string);
+                case 't':
+                    value.type = json_value::kind::BOOLEAN;
+                    value.boolean = true;
+                    return consume_literal("true");
+                case 'f':
+                    value.type = json_value::kind::BOOLEAN;
+                    value.boolean = false;
+                    return consume_literal("false");
+                case 'n':
+                    value.type = json_value::kind::NUL;
+                    return consume_literal("null");
+                default:
+                    return parse_number(value);
+            }
+        }
+
+        bool parse_object(json_value &value, unsigned depth) {
+            value.type = json_value::kind::OBJECT;
+            pos++;
+            if (consume('}')) {
+                return true;
+            }
+            do {
+                skip_whitespace();
+                std::string key;
+                if (pos >= text.size() || text[pos] != '"' || !parse_string(key)) {
+                    return error.empty() ? fail("expected member name") : false;
+                }
+                if (!consume(':')) {
+                    return fail("expected ':'");
+                }
+                value.object.emplace_back(key, json_value());
+                if (!parse_value(value.object.back().second, depth + 1)) {
+                    return false;
+                }
+            } while (consume(','));
+            if (!consume('}')) {
+                return fail("expected ',' or '}'");
+            }
+            return true;
+        }
+
+        bool parse_array(json_value &value, unsigned depth) {
+            value.type = json_value::kind::ARRAY;
+            pos++;
+            if (consume(']')) {
+                return true;
+            }
+            do {
+                value.array.emplace_back();
+                if (!parse_value(value.array.back(), depth + 1)) {
+                    return false;
+                }
+            } while (consume(','));
+            if (!consume(']')) {
+                return fail("expected ',' or ']'");
+            }
+            return true;
+        }
+
+        // escapes other than \uXXXX are kept, \uXXXX is replaced by '?'
+        // as the benchmark output is ASCII only
+        bool parse_string(std::string &out) {
+            pos++;
+            while (pos < text.size() && text[pos] != '"') {
+                char c = text[pos++];
+                if (c == '\\') {
+                    if (pos >= text.size()) {
+                        break;
+                    }
+                    c = text[pos++];
+                    switch (c) {
+                        case 'n': c = '\n'; break;
+                        case 't': c = '\t'; break;
+                        case 'r': c = '\r'; break;
+                        case 'b': c = '\b'; break;
+                        case 'f': c = '\f'; break;
+                        case 'u':
+                            if (pos + 4 > text.size()) {
+                                return fail("invalid escape");
+                            }
+                            pos += 4;
+                            c = '?';
+                            break;
+                        default: break;
+                    }
+                }
+                out.push_back(c);
+            }
+            if (pos >= text.size()) {
+                return fail("unterminated string");
+            }
+            pos++;
+            return true;
+        }
+
+        bool parse_number(json_value &value) {
+            const char *begin = text.c_str() + pos;
+            char *end = nullptr;
+            value.type = json_value::kind::NUMBER;
+            value.number = std::strtod(begin, &end);
+            if (end == begin) {
+                return fail("unexpected character");
+            }
+            pos += end - begin;
+            return true;
+        }
+};
+
+}
+
+bool parse_json(const std::string &text, json_value &value, std::string &error) {
+    value = json_value();
+    error.clear();
+    json_parser parser(text, error);
+    return parser.parse_document(value);
+}
@@ -0,0 +1,36 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal JSON document model and parser, sufficient to read back the
+// results written by the benchmark suite.
+struct json_value {
+    enum class kind { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+    kind type{kind::NUL};
+    bool boolean{false};
+    double number{0.0};
+    std::string string;
+    std::vector<json_value> array;
+    // members in the order of the document
+    std::vector<std::pair<std::string, json_value>> object;
+
+    // member key of an object, nullptr if there is none
+    const json_value *get(const std::string &key) const;
+
+    // value of member key if it is a number, fallback otherwise
+    double get_number(const std::string &key, double fallback = 0.0) const;
+
+    // value of member key if it is a string, fallback otherwise
+    std::string get_string(const std::string &key, const std::string &fallback = "") const;
+};
+
+// parses text into value, returns false and sets error on malformed input
+bool parse_json(const std::string &text, json_value &value, std::string &error);
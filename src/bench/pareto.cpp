@@ -0,0 +1,24 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "bench/pareto.h"
+
+#include <algorithm>
+
+void mark_pareto_frontier(std::vector<pareto_point> &points) {
+    std::sort(points.begin(), points.end(), [] (const pareto_point &lop, const pareto_point &rop) {
+        return lop.time < rop.time || (lop.time == rop.time && lop.weight > rop.weight);
+    });
+    bool first = true;
+    double heaviest = 0.0;
+    for (auto &p : points) {
+        p.pareto = first || p.weight > heaviest;
+        if (p.pareto) {
+            heaviest = p.weight;
+            first = false;
+        }
+    }
+}
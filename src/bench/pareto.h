@@ -0,0 +1,26 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+
+// Quality-versus-time trade-off of the algorithms on one instance and b.
+
+// median time and weight of one algorithm variant
+struct pareto_point {
+    std::string algorithm;
+    std::string short_name;
+    double time{0.0};
+    double weight{0.0};
+    // not dominated by any other point
+    bool pareto{false};
+};
+
+// sorts points by time, ties by decreasing weight, and marks those no
+// other point dominates, i.e., that are strictly heavier than every
+// faster point
+void mark_pareto_frontier(std::vector<pareto_point> &points);
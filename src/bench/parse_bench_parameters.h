@@ -0,0 +1,233 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include "bench/bench_config.h"
+#include "matching/matching_config.h"
+#include "extern/argtable3-3.0.3/argtable3.h"
+
+int parse_bench_parameters(int argn, char **argv, BenchConfig &bench_config,
+        MatchingConfig &matching_config, bool &ret) {
+
+    const char *progname = argv[0];
+
+    struct arg_lit *help = arg_lit0(NULL, "help", "Print help.");
+    struct arg_str *generator = arg_strn(NULL, "generator", "NAME", 0, 6, "instance generator, any of: rmat-b, rmat-g, rmat-er, er, ba, datacenter (default: all)");
+    struct arg_int *min_log_n = arg_int0(NULL, "min-log-n", NULL, "smallest instances have 2^N vertices (default 10)");
+    struct arg_int *max_log_n = arg_int0(NULL, "max-log-n", NULL, "largest instances have 2^N vertices (default 14, at most 26)");
+    struct arg_int *log_edge_factor = arg_int0(NULL, "log-edge-factor", NULL, "sample 2^(N + F) arcs for 2^N vertices (default 3)");
+    struct arg_dbl *weight_mean = arg_dbl0(NULL, "weight-mean", NULL, "mean weight of a sampled arc (default 8192)");
+    struct arg_int *seed = arg_int0(NULL, "seed", NULL, "seed for the generators and randomized algorithms (default 1)");
+    struct arg_int *b = arg_intn(NULL, "b", NULL, 0, 10, "number of matchings (default: 1, 2, 4, 8)");
+    struct arg_int *warmup = arg_int0(NULL, "warmup", NULL, "untimed runs per algorithm and b (default 1)");
+    struct arg_int *repetitions = arg_int0(NULL, "repetitions", NULL, "timed runs per algorithm and b (default 5)");
+    struct arg_str *filter = arg_str0(NULL, "filter", "TEXT", "only run algorithms whose short name contains TEXT");
+    struct arg_int *l = arg_int0(NULL, "l", NULL, "also run GPA-ROMA with l iterations of improvements");
+    struct arg_dbl *global_threshold = arg_dbln("t", "threshold", NULL, 0, 100, "also run Node-Centered with threshold t");
+    struct arg_int *threads = arg_int0(NULL, "threads", "N", "threads for the generators (default 0: one per core)");
+    struct arg_str *output = arg_str0(NULL, "output", "FILE", "write the JSON results to FILE instead of stdout");
+    struct arg_str *results_output = arg_str0(NULL, "results-output", "FILE", "append every timed run to the results CSV file FILE, as DJMatch does");
+    struct arg_str *baseline = arg_str0(NULL, "baseline", "FILE", "regression mode: rerun the instances, b and algorithms of the JSON results in FILE and fail on significant slowdowns or weight changes");
+    struct arg_dbl *max_slowdown = arg_dbl0(NULL, "max-slowdown", "PCT", "with --baseline: tolerated slowdown of the mean time in percent (default 5)");
+    struct arg_dbl *max_weight_change = arg_dbl0(NULL, "max-weight-change", "PCT", "with --baseline: tolerated change of the mean weight in percent (default 0)");
+    struct arg_lit *pareto = arg_lit0(NULL, "pareto", "Pareto mode: report the algorithm variants with the best weight for their time per instance and b, with the weight relative to an upper bound");
+    struct arg_int *pareto_l = arg_intn(NULL, "pareto-l", NULL, 0, 10, "with --pareto: run GPA-ROMA with each of these l (default: 1, 2, 4, 8)");
+    struct arg_end *end = arg_end(100);
+
+    void *argtable[] = {
+            help, generator,
+            min_log_n, max_log_n, log_edge_factor, weight_mean, seed,
+            b, warmup, repetitions, filter,
+            l, global_threshold, threads,
+            output, results_output,
+            baseline, max_slowdown, max_weight_change,
+            pareto, pareto_l,
+            end
+    };
+
+    // Parse arguments.
+    int nerrors = arg_parse(argn, argv, argtable);
+    ret = false;
+
+    // Catch case that help was requested.
+    if (help->count > 0) {
+        printf("Usage: %s", progname);
+        arg_print_syntax(stdout, argtable, "\n");
+        arg_print_glossary(stdout, argtable,"  %-40s %s\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        ret = true;
+        return 0;
+    }
+
+    if (nerrors > 0) {
+        arg_print_errors(stderr, end, progname);
+        printf("Try '%s --help' for more information.\n",progname);
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    for (auto i = 0; i < generator->count; i++) {
+        instance_type type;
+        if (!parse_instance_type(generator->sval[i], type)) {
+            printf("Invalid generator passed! %s\n", generator->sval[i]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        bench_config.generators.push_back(type);
+    }
+    if (bench_config.generators.empty()) {
+        bench_config.generators = all_instance_types();
+    }
+
+    if (min_log_n->count > 0) {
+        bench_config.min_log_n = min_log_n->ival[0];
+    }
+    if (max_log_n->count > 0) {
+        bench_config.max_log_n = max_log_n->ival[0];
+    }
+    if (min_log_n->count > 0 && max_log_n->count == 0) {
+        bench_config.max_log_n = std::max(bench_config.min_log_n, bench_config.max_log_n);
+    }
+    if (bench_config.min_log_n < 1 || bench_config.max_log_n > 26
+            || bench_config.min_log_n > bench_config.max_log_n) {
+        printf("Invalid instance sizes passed! 2^%u to 2^%u vertices\n", bench_config.min_log_n, bench_config.max_log_n);
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+    if (log_edge_factor->count > 0) {
+        if (log_edge_factor->ival[0] < 0 || log_edge_factor->ival[0] > 10) {
+            printf("Invalid edge factor passed! %d\n", log_edge_factor->ival[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        bench_config.log_edge_factor = log_edge_factor->ival[0];
+    }
+    if (weight_mean->count > 0) {
+        if (weight_mean->dval[0] < 1.0) {
+            printf("Invalid weight mean passed! %f\n", weight_mean->dval[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        bench_config.weight_mean = weight_mean->dval[0];
+    }
+    if (seed->count > 0) {
+        bench_config.seed = seed->ival[0];
+        matching_config.seed = seed->ival[0];
+    }
+
+    for (auto i = 0; i < b->count; i++) {
+        if (b->ival[i] <= 0) {
+            printf("Invalid b passed! %d\n", b->ival[i]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        bench_config.bs.push_back(b->ival[i]);
+    }
+    if (bench_config.bs.empty()) {
+        bench_config.bs = {1, 2, 4, 8};
+    }
+
+    if (warmup->count > 0) {
+        if (warmup->ival[0] < 0) {
+            printf("Invalid number of warm-up runs passed! %d\n", warmup->ival[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        bench_config.warmup = warmup->ival[0];
+    }
+    if (repetitions->count > 0) {
+        if (repetitions->ival[0] <= 0) {
+            printf("Invalid number of repetitions passed! %d\n", repetitions->ival[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        bench_config.repetitions = repetitions->ival[0];
+    }
+
+    if (filter->count > 0) {
+        bench_config.filter = filter->sval[0];
+    }
+
+    if (l->count > 0) {
+        matching_config.l = l->ival[0];
+        matching_config.roma = true;
+    }
+
+    for (auto i = 0; i < global_threshold->count; i++) {
+        matching_config.global_thresholds.push_back(global_threshold->dval[i]);
+    }
+
+    if (threads->count > 0) {
+        if (threads->ival[0] < 0) {
+            printf("Invalid number of threads passed! %d\n", threads->ival[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        matching_config.threads = threads->ival[0];
+    }
+
+    if (output->count > 0) {
+        bench_config.output = output->sval[0];
+    }
+
+    if (results_output->count > 0) {
+        bench_config.results_output = results_output->sval[0];
+    }
+
+    if (baseline->count > 0) {
+        if (bench_config.repetitions < 2) {
+            printf("--baseline requires at least 2 repetitions!\n");
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        bench_config.baseline = baseline->sval[0];
+    }
+    if (max_slowdown->count > 0) {
+        if (max_slowdown->dval[0] < 0) {
+            printf("Invalid slowdown passed! %f\n", max_slowdown->dval[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        bench_config.max_slowdown = max_slowdown->dval[0] / 100.0;
+    }
+    if (max_weight_change->count > 0) {
+        if (max_weight_change->dval[0] < 0) {
+            printf("Invalid weight change passed! %f\n", max_weight_change->dval[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        bench_config.max_weight_change = max_weight_change->dval[0] / 100.0;
+    }
+
+    if (pareto->count > 0) {
+        if (!bench_config.baseline.empty()) {
+            printf("--pareto and --baseline cannot be combined!\n");
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        bench_config.pareto = true;
+        for (auto i = 0; i < pareto_l->count; i++) {
+            if (pareto_l->ival[i] <= 0) {
+                printf("Invalid l passed! %d\n", pareto_l->ival[i]);
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+            }
+            bench_config.pareto_ls.push_back(pareto_l->ival[i]);
+        }
+        if (bench_config.pareto_ls.empty()) {
+            bench_config.pareto_ls = {1, 2, 4, 8};
+        }
+        if (matching_config.global_thresholds.empty()) {
+            matching_config.global_thresholds = {0.01, 0.05, 0.1, 0.25};
+        }
+    }
+
+    arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+    return 0;
+}
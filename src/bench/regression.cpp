@@ -0,0 +1,125 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "bench/regression.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "bench/json_reader.h"
+
+namespace {
+
+bool read_samples(const json_value &result, const std::string &key, std::vector<double> &samples) {
+    auto *summary = result.get(key);
+    auto *values = summary != nullptr ? summary->get("samples") : nullptr;
+    if (values == nullptr || values->type != json_value::kind::ARRAY || values->array.empty()) {
+        return false;
+    }
+    for (const auto &value : values->array) {
+        if (value.type != json_value::kind::NUMBER) {
+            return false;
+        }
+        samples.push_back(value.number);
+    }
+    return true;
+}
+
+}
+
+bool read_baseline(const std::string &filename, baseline_run &baseline, std::string &error) {
+    std::ifstream in(filename);
+    if (!in.is_open()) {
+        error = "could not open " + filename;
+        return false;
+    }
+    std::stringstream text;
+    text << in.rdbuf();
+    json_value root;
+    if (!parse_json(text.str(), root, error)) {
+        error = filename + ": " + error;
+        return false;
+    }
+    auto *results = root.get("results");
+    if (results == nullptr || results->type != json_value::kind::ARRAY) {
+        error = filename + ": no results";
+        return false;
+    }
+
+    baseline.git_revision = root.get_string("git_revision");
+    baseline.l = static_cast<int>(root.get_number("l", -1));
+    if (auto *thresholds = root.get("thresholds")) {
+        for (const auto &t : thresholds->array) {
+            baseline.thresholds.push_back(t.number);
+        }
+    }
+    const auto seed = static_cast<unsigned long>(root.get_number("seed", 1));
+
+    for (const auto &result : results->array) {
+        baseline_entry entry;
+        entry.instance = result.get_string("instance");
+        entry.algorithm = result.get_string("short_name");
+        entry.b = static_cast<unsigned>(result.get_number("b", 0));
+        if (!parse_instance_type(result.get_string("generator"), entry.params.type)
+                || result.get("log_m") == nullptr || entry.b == 0 || entry.algorithm.empty()) {
+            error = filename + ": incomplete result for " + entry.instance + " " + entry.algorithm;
+            return false;
+        }
+        entry.params.log_n = static_cast<unsigned>(result.get_number("log_n"));
+        entry.params.log_m = static_cast<unsigned>(result.get_number("log_m"));
+        entry.params.weight_mean = result.get_number("weight_mean", entry.params.weight_mean);
+        entry.params.seed = seed;
+        if (!read_samples(result, "time_s", entry.times) || !read_samples(result, "weight", entry.weights)) {
+            error = filename + ": no samples for " + entry.instance + " " + entry.algorithm
+                + " b=" + std::to_string(entry.b) + ", rerun the baseline with this version";
+            return false;
+        }
+        baseline.entries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+comparison compare_to_baseline(const baseline_entry &baseline, const std::vector<double> &times,
+        const std::vector<double> &weights, const regression_limits &limits) {
+    comparison result;
+    if (times.empty()) {
+        result.verdict = comparison_verdict::MISSING;
+        return result;
+    }
+    result.time = mean_difference(baseline.times, times, limits.confidence);
+    result.weight = mean_difference(baseline.weights, weights, limits.confidence);
+
+    const auto weight_limit = limits.max_weight_change * std::abs(result.weight.baseline_mean);
+    const auto time_limit = limits.max_slowdown * result.time.baseline_mean;
+    if (result.weight.low > weight_limit || result.weight.high < -weight_limit) {
+        result.verdict = comparison_verdict::WEIGHT_CHANGED;
+    } else if (baseline.times.size() < 2 || times.size() < 2) {
+        result.verdict = comparison_verdict::INCONCLUSIVE;
+    } else if (result.time.low > time_limit) {
+        result.verdict = comparison_verdict::SLOWER;
+    } else if (result.time.high < -time_limit) {
+        result.verdict = comparison_verdict::FASTER;
+    }
+    return result;
+}
+
+std::string verdict_name(comparison_verdict verdict) {
+    switch (verdict) {
+        case comparison_verdict::FASTER:
+            return "faster";
+        case comparison_verdict::SLOWER:
+            return "SLOWER";
+        case comparison_verdict::WEIGHT_CHANGED:
+            return "WEIGHT CHANGED";
+        case comparison_verdict::MISSING:
+            return "MISSING";
+        case comparison_verdict::INCONCLUSIVE:
+            return "inconclusive";
+        default:
+            return "ok";
+    }
+}
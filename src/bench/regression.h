@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+
+#include "bench/bench_statistics.h"
+#include "bench/generators.h"
+
+// Regression checks against the JSON results of an earlier benchmark run.
+
+// one (instance, b, algorithm) result of the baseline with its samples
+struct baseline_entry {
+    instance_params params;
+    std::string instance;
+    unsigned b{1};
+    std::string algorithm;
+    std::vector<double> times;
+    std::vector<double> weights;
+};
+
+struct baseline_run {
+    std::string git_revision;
+    int l{-1};
+    std::vector<double> thresholds;
+    std::vector<baseline_entry> entries;
+};
+
+// reads a JSON file written by the benchmark suite; fails on files
+// without per-repetition samples, i.e., of older versions
+bool read_baseline(const std::string &filename, baseline_run &baseline, std::string &error);
+
+struct regression_limits {
+    // relative slowdown of the mean time that is tolerated even if
+    // significant, e.g., 0.05 for 5%
+    double max_slowdown{0.05};
+    // relative change of the mean weight that is tolerated
+    double max_weight_change{0.0};
+    double confidence{0.95};
+};
+
+enum class comparison_verdict { UNCHANGED, FASTER, SLOWER, WEIGHT_CHANGED, MISSING, INCONCLUSIVE };
+
+struct comparison {
+    difference_interval time;
+    difference_interval weight;
+    comparison_verdict verdict{comparison_verdict::UNCHANGED};
+
+    bool regression() const noexcept {
+        return verdict == comparison_verdict::SLOWER || verdict == comparison_verdict::WEIGHT_CHANGED
+            || verdict == comparison_verdict::MISSING;
+    }
+};
+
+// a change is only flagged if the whole confidence interval of the
+// difference of the means lies beyond the limit; times are inconclusive
+// if either side has fewer than two samples, as there is no variance to
+// judge the difference by
+comparison compare_to_baseline(const baseline_entry &baseline, const std::vector<double> &times,
+        const std::vector<double> &weights, const regression_limits &limits);
+
+std::string verdict_name(comparison_verdict verdict);
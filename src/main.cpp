@@ -14,36 +14,807 @@
 #include <ratio>
 #include <iomanip>
 #include <random>
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+#include <sstream>
 
 #include "djmatch_info.h"
+#include "tools/allocation_counter.h"
 #include "tools/chronotimer.h"
+#include "tools/memory_usage.h"
+#include "tools/parallel.h"
+#include "tools/perf_counters.h"
+#include "tools/trace.h"
 #include "matching/matching_config.h"
 #include "parse_parameters.h"
+#include "results_csv.h"
 #include "matching/matching_algorithm.h"
 #include "matching/greedy_b_matching.h"
 #include "matching/greedy_iterative.h"
 #include "matching/node_centered.h"
 #include "matching/gpa/gpa.h"
+#include "matching/gpa/gpa_multi_seed.h"
 #include "matching/coloring/k_edge_coloring.hpp"
+#include "matching/algorithm_factory.h"
+#include "matching/portfolio.h"
+#include "matching/matching_stream.h"
+#include "matching/solution_writer.h"
+#include "matching/dynamic/k_matching_repair.h"
+#include "matching/dynamic/demand_window.h"
+#include "matching/components/component_solver.h"
+#include "matching/normalized_graph.h"
+#include "matching/upper_bounds.h"
 #include "graph.dyn/dynamicweighteddigraph.h"
 #include "io/konectnetworkreader.h"
 
 
 std::ofstream outfile;
+std::ofstream difffile;
+std::ofstream phasefile;
+bool collect_perf_counters = false;
+// account allocations of all threads to a run, only if runs are sequential
+bool process_wide_allocations = true;
 
 bool file_exists(const std::string &filename) {
     struct stat buffer;
     return (stat(filename.c_str(), &buffer) == 0);
 }
 
-void write_result(MatchingConfig & config, const matching_algorithm &algorithm, double time, unsigned long weight) {
+AllocationStats current_allocations() {
+    return process_wide_allocations ? process_allocations() : thread_allocations();
+}
+
+// hardware counters of the calling thread, nullptr if not requested
+// or not available
+const PerfCounters *thread_perf_counters() {
+    if (!collect_perf_counters) {
+        return nullptr;
+    }
+    thread_local PerfCounters counters;
+    return counters.available() ? &counters : nullptr;
+}
+
+void write_result(MatchingConfig & config, double threshold, const std::string &short_name, const algorithm_result &result,
+        int seed) {
     if (config.writeOutputfile) {
-        outfile << config.graph_filename << "," << config.b << ","
-            << config.seed << "," << config.l << ","
-            << algorithm.getThreshold() << ","
-            << algorithm.getShortName() << "," << time << "," << weight
+        write_result_row(outfile, config, seed, threshold, short_name, result);
+    }
+}
+
+void write_result(MatchingConfig & config, double threshold, const std::string &short_name, const algorithm_result &result) {
+    write_result(config, threshold, short_name, result, config.seed);
+}
+
+void write_result(MatchingConfig & config, const matching_algorithm &algorithm, const algorithm_result &result) {
+    write_result(config, algorithm.getThreshold(), algorithm.getShortName(), result);
+}
+
+algorithm_result run_algorithm(matching_algorithm &algo, unsigned b) {
+    auto &trace = TraceRecorder::instance();
+    ScopedTrace run_trace(trace.is_enabled() ? trace.intern(algo.getShortName()) : nullptr);
+    algorithm_result result;
+    const auto *counters = thread_perf_counters();
+    if (process_wide_allocations) {
+        reset_peak_rss();
+    }
+    const auto rss_before = current_rss_kb();
+    const auto allocations_before = current_allocations();
+    algo.set_perf_counters(counters);
+    bool prepared;
+    {
+        DJM_TRACE("prepare");
+        algo.set_num_matchings(b);
+        prepared = algo.prepare();
+    }
+    if (!prepared) {
+        algo.set_perf_counters(nullptr);
+        return result;
+    }
+    result.prepared = true;
+    PerfSample counters_before;
+    if (counters != nullptr) {
+        counters_before = counters->read();
+    }
+    ChronoTimer t;
+    ThreadCpuTimer cpu_t;
+    algo.run();
+    result.time = t.elapsed<>();
+    result.cpu_time = cpu_t.elapsed();
+    if (counters != nullptr) {
+        result.counters = counters->read() - counters_before;
+    }
+    // the counters belong to this thread
+    algo.set_perf_counters(nullptr);
+    result.allocations = current_allocations() - allocations_before;
+    result.rss_delta_kb = std::max(0L, peak_rss_kb() - rss_before);
+    result.weight = algo.deliver();
+    return result;
+}
+
+// incremental multi-b: runs algo once for the largest b and takes weight
+// and time for every smaller b as soon as its last matching is complete;
+// algo must compute its matchings incrementally
+std::vector<algorithm_result> run_algorithm_prefixes(matching_algorithm &algo, const std::vector<int> &bs) {
+    std::vector<algorithm_result> results(bs.size());
+    const auto max_b = *std::max_element(bs.begin(), bs.end());
+    if (max_b <= 0) {
+        return results;
+    }
+    std::vector<algorithm_result> per_matching(max_b);
+    algo.set_num_matchings(max_b);
+    if (!algo.prepare()) {
+        return results;
+    }
+    ChronoTimer t;
+    ThreadCpuTimer cpu_t;
+    algo.set_matching_listener([&] (const matching_algorithm::color_t &c) {
+        auto &result = per_matching[c];
+        result.time = t.elapsed<>();
+        result.cpu_time = cpu_t.elapsed();
+        result.weight = algo.deliver();
+        result.prepared = true;
+    });
+    algo.run();
+    algo.set_matching_listener(nullptr);
+    for (auto i = 0UL; i < bs.size(); i++) {
+        if (bs[i] > 0) {
+            results[i] = per_matching[bs[i] - 1];
+        }
+    }
+    return results;
+}
+
+// writes a solution for config.b by write(filename, options, error) to
+// config.solution_output, or to a file of its own, named after
+// short_name, if there are several algorithms or values of b;
+// returns the table line to print
+template <typename Write>
+std::string output_solution(const MatchingConfig &config, const std::string &short_name,
+        bool single_solution, const std::vector<unsigned long> *vertex_ids, Write write) {
+    auto filename = config.solution_output;
+    if (!single_solution) {
+        auto name = short_name;
+        std::replace_if(name.begin(), name.end(), [] (char c) {
+            return !std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_' && c != '+';
+        }, '_');
+        filename += "." + name + ".b" + std::to_string(config.b);
+    }
+    solution_writer_options options;
+    options.format = config.solution_binary ? solution_format::BINARY : solution_format::TEXT;
+    options.use_mmap = config.solution_mmap;
+    options.threads = config.threads;
+    options.vertex_ids = vertex_ids;
+
+    DJM_TRACE("output");
+    ChronoTimer t;
+    std::string error;
+    if (!write(filename, options, error)) {
+        return "|   Error! " + error + "\n";
+    }
+    std::ostringstream line;
+    line << "|   solution written to " << filename << " in " << std::fixed << std::setprecision(6)
+        << t.elapsed<>() << "s\n";
+    return line.str();
+}
+
+// writes the solution of algo, see above
+std::string output_solution(const MatchingConfig &config, const matching_algorithm &algo,
+        Algora::DiGraph *graph, bool single_solution, const std::vector<unsigned long> *vertex_ids) {
+    return output_solution(config, algo.getShortName(), single_solution, vertex_ids,
+            [&config,&algo,graph] (const std::string &filename, const solution_writer_options &options,
+                std::string &error) {
+        return write_solution(filename, graph, algo, config.b, options, error);
+    });
+}
+
+// prints the table row of an algorithm, except for its name
+void print_result(const algorithm_result &result) {
+    if (!result.prepared) {
+        std::cout  << std::right << " | "
+            << std::setw(95)
+            << " FAILED TO PREPARE "
+            << " |\n";
+        return;
+    }
+    std::cout  << std::right << " | "
+        << std::setw(20)
+        << result.weight
+        << " | "
+        << std::setw(12)
+        << std::fixed << std::setprecision(6)
+        << result.time
+        << " | "
+        << std::setw(12)
+        << result.cpu_time
+        << " | "
+        << std::setw(12)
+        << result.rss_delta_kb
+        << " | "
+        << std::setw(12)
+        << result.allocations.bytes / 1024
+        << " | "
+        << std::setw(12)
+        << result.allocations.count;
+    if (result.fractional_bound > 0) {
+        std::cout << " | " << std::setw(9) << std::setprecision(2)
+            << 100.0 * result.weight / result.fractional_bound << "%";
+    }
+    std::cout << " |\n";
+    if (result.counters.any_valid()) {
+        std::cout << "|  ";
+        for (auto c = 0; c < PerfSample::NUM_COUNTERS; c++) {
+            if (result.counters.valid[c]) {
+                std::cout << " " << PerfSample::name(static_cast<PerfSample::counter>(c))
+                    << " " << result.counters.values[c];
+            }
+        }
+        if (result.counters.ipc() > 0) {
+            std::cout << " IPC " << std::setprecision(2) << result.counters.ipc() << std::setprecision(6);
+        }
+        std::cout << "\n";
+    }
+}
+
+// table line on how much the solution of algo differs from the warm
+// start, must be called while the graph algo ran on is still current
+std::string warm_start_summary(const std::vector<solution_link> &links, matching_algorithm &algo,
+        Algora::DiGraph *graph) {
+    if (!algo.supportsWarmStart()) {
+        return "|   warm start not supported, solved from scratch\n";
+    }
+    auto matched = 0UL;
+    graph->mapArcs([&algo,&matched] (Algora::Arc *arc) {
+        if (algo.isMatched(arc)) {
+            matched++;
+        }
+    });
+    const auto unchanged = algo.num_unchanged_warm_start_arcs();
+    return "|   warm start: " + std::to_string(algo.num_warm_start_arcs()) + " of " + std::to_string(links.size())
+        + " links applied, " + std::to_string(unchanged) + " unchanged, "
+        + std::to_string((links.size() - unchanged) + (matched - unchanged)) + " links reconfigured\n";
+}
+
+// table lines with the time per phase of the last run of algo,
+// indented by nesting depth, relative to the total running time
+std::string phase_summary(const matching_algorithm &algo, const algorithm_result &result) {
+    const auto &phases = algo.get_phase_times();
+    std::ostringstream summary;
+    summary << std::fixed;
+    phases.map_phases([&phases,&result,&summary] (std::size_t index, unsigned depth) {
+        const auto &phase = phases[index];
+        summary << "|   " << std::string(2 * depth, ' ') << std::left
+            << std::setw(36 - 2 * depth) << phase.name << std::right
+            << std::setprecision(6) << std::setw(12) << phase.seconds << "s"
+            << std::setprecision(1) << std::setw(7)
+            << (result.time > 0 ? 100.0 * phase.seconds / result.time : 0.0) << "%";
+        if (phase.count > 1) {
+            summary << "  x" << phase.count;
+        }
+        const auto &counters = phase.counters;
+        if (counters.ipc() > 0) {
+            summary << "  IPC " << std::setprecision(2) << counters.ipc();
+        }
+        if (counters.valid[PerfSample::LLC_MISSES]) {
+            summary << "  LLC " << counters.values[PerfSample::LLC_MISSES];
+        }
+        if (counters.valid[PerfSample::DTLB_MISSES]) {
+            summary << "  dTLB " << counters.values[PerfSample::DTLB_MISSES];
+        }
+        if (counters.valid[PerfSample::BRANCH_MISSES]) {
+            summary << "  br " << counters.values[PerfSample::BRANCH_MISSES];
+        }
+        summary << "\n";
+    });
+    return summary.str();
+}
+
+// table line with the events of the last run of algo, empty if there were none
+std::string event_summary(const matching_algorithm &algo) {
+    const auto &events = algo.get_event_counters();
+    if (events.empty()) {
+        return "";
+    }
+    std::ostringstream summary;
+    summary << std::fixed << std::setprecision(2) << "|   events:";
+    bool first = true;
+    for (auto i = 0UL; i < event_counters::NUM_EVENTS; i++) {
+        const auto e = static_cast<event_type>(i);
+        const auto &stat = events[e];
+        if (stat.count == 0) {
+            continue;
+        }
+        summary << (first ? " " : ", ") << event_counters::name(e) << " ";
+        if (event_counters::has_size(e)) {
+            summary << "n=" << stat.count << " avg=" << static_cast<double>(stat.sum) / stat.count
+                << " max=" << stat.max;
+        } else {
+            summary << stat.count;
+        }
+        first = false;
+    }
+    summary << "\n";
+    return summary.str();
+}
+
+void write_phases(const MatchingConfig &config, const matching_algorithm &algo) {
+    if (!phasefile.is_open()) {
+        return;
+    }
+    const auto &phases = algo.get_phase_times();
+    phases.map_phases([&] (std::size_t index, unsigned depth) {
+        phasefile << config.graph_filename << "," << config.b << "," << config.seed << ","
+            << algo.getShortName() << "," << phases.path(index) << "," << depth << ","
+            << phases[index].seconds << "," << phases[index].count;
+        write_counters(phasefile, phases[index].counters);
+        phasefile << "\n";
+    });
+}
+
+// writes the trace when main returns, whichever way
+struct trace_writer {
+    std::string filename;
+
+    ~trace_writer() {
+        if (filename.empty()) {
+            return;
+        }
+        std::ofstream out(filename);
+        if (!out.is_open()) {
+            std::cout << "Error! Could not open file " << filename << "\n";
+            return;
+        }
+        TraceRecorder::instance().write(out);
+    }
+};
+
+// summary of the last run of a component solver, one row per component
+// with console_log
+std::string component_summary(const MatchingConfig &config, const component_solver &solver) {
+    const auto &stats = solver.get_component_stats();
+    std::ostringstream summary;
+    summary << "|   " << stats.size() << " components";
+    if (!stats.empty()) {
+        summary << ", largest with " << stats.front().vertices << " vertices and "
+            << stats.front().arcs << " arcs";
+    }
+    summary << ", decomposed in " << std::fixed << std::setprecision(6)
+        << solver.decomposition_time() << "s\n";
+    if (config.console_log) {
+        for (auto i = 0UL; i < stats.size(); i++) {
+            summary << "|     #" << i << ": " << stats[i].vertices << " vertices, " << stats[i].arcs
+                << " arcs, weight " << stats[i].weight << ", " << stats[i].time << "s\n";
+        }
+    }
+    return summary.str();
+}
+
+// writes the links changed per matching by the last repair, label maps
+// vertex ids to the ids of the input
+template <typename Label>
+void write_diff(const std::string &epoch, k_matching_repair &repair, Label label) {
+    if (!difffile.is_open()) {
+        return;
+    }
+    difffile << "% " << epoch << " weight " << repair.deliver()
+        << " switches " << repair.num_switches() << "\n";
+    for (const auto &change : repair.get_changes()) {
+        difffile << (change.added ? "+ " : "- ") << label(change.tail) << " " << label(change.head)
+            << " " << change.color << "\n";
+    }
+}
+
+// weight minus switching cost
+long long repair_objective(EdgeWeight weight, unsigned long switches, EdgeWeight penalty) {
+    return static_cast<long long>(weight) - static_cast<long long>(switches * penalty);
+}
+
+// dynamic mode: applies all further deltas of G and repairs the
+// solution of algo after each of them
+void run_dynamic(MatchingConfig &config, Algora::DynamicWeightedDiGraph<unsigned long> &G,
+        matching_algorithm &algo) {
+    k_matching_repair repair(config);
+    repair.set_max_vertex_id(G.getMaxVertexId());
+    repair.setGraph(G.getDiGraph());
+    repair.setWeights(G.getArcWeights());
+    repair.set_num_matchings(config.b);
+    repair.set_switch_penalty(config.switch_penalty);
+    repair.adopt(algo);
+    repair.observe_graph();
+
+    ChronoTimer t;
+    auto deltas = 0UL;
+    auto total_time = 0.0;
+    auto max_time = 0.0;
+    auto detect_time = 0.0;
+    auto switches = 0UL;
+    auto objective = 0LL;
+    while (G.applyNextDelta()) {
+        deltas++;
+        // finding weight changes scans all arcs; as long as the delta
+        // can't tell which arcs it changed, this is part of the latency
+        // per delta, but its share is reported as well
+        t.restart();
+        auto weight_changes = repair.detect_weight_changes();
+        const auto detect = t.elapsed<>();
+        detect_time += detect;
+        auto dirty = repair.num_dirty_vertices();
+        t.restart();
+        repair.run();
+        auto time = detect + t.elapsed<>();
+        total_time += time;
+        max_time = std::max(max_time, time);
+        switches += repair.num_switches();
+        objective += repair_objective(repair.deliver(), repair.num_switches(), config.switch_penalty);
+        write_diff(algo.getShortName() + " b=" + std::to_string(config.b) + " delta " + std::to_string(deltas),
+                repair, [] (unsigned long long id) { return id; });
+        if (config.console_log) {
+            std::cout << "|   delta " << std::left << std::setw(32) << deltas
+                << std::right << " | "
+                << std::setw(20) << repair.deliver()
+                << " | "
+                << std::setw(12) << std::fixed << std::setprecision(6) << time
+                << " | "
+                << std::setw(12) << dirty << " |"
+                << " (" << weight_changes << " weight changes, "
+                << repair.num_switches() << " switches)\n";
+        }
+    }
+    repair.stop_observing_graph();
+
+    std::cout << "| " << std::left << std::setw(40) << ("  + repair after " + std::to_string(deltas) + " deltas")
+        << std::right << " | "
+        << std::setw(20) << repair.deliver()
+        << " | "
+        << std::setw(12) << std::fixed << std::setprecision(6) << total_time
+        << " | "
+        << std::setw(12) << max_time
+        << " |\n";
+    std::cout << "|   " << switches << " switches in total";
+    if (config.switch_penalty > 0) {
+        std::cout << ", summed weight minus switching cost " << objective;
+    }
+    std::cout << ", of the repair time " << std::fixed << std::setprecision(6)
+        << detect_time << "s for detecting weight changes\n";
+    algorithm_result result;
+    result.prepared = true;
+    result.weight = repair.deliver();
+    result.time = total_time;
+    write_result(config, algo.getThreshold(), algo.getShortName() + "+repair", result);
+}
+
+// writes the matching of the current window in the input labels;
+// read_solution() rejects these files, as the ids of other modes differ
+void write_window(std::ofstream &file, demand_window &windows,
+        const matching_algorithm &algo, const std::string &name, EdgeWeight weight) {
+    file << "% window " << windows.window_begin() << " " << windows.window_end()
+        << " " << name << " weight " << weight << "\n";
+    windows.getDiGraph()->mapArcs([&file,&windows,&algo] (Algora::Arc *arc) {
+        if (algo.isMatched(arc) && windows.getArcWeights()->getValue(arc) > 0) {
+            file << windows.vertex_label(arc->getTail()) << " "
+                << windows.vertex_label(arc->getHead()) << " " << algo.getEdgeColor(arc) << "\n";
+        }
+    });
+}
+
+// prints the table row of a window
+void print_window(const demand_window &windows, EdgeWeight weight, double time,
+        const std::string &note = "") {
+    std::cout << "|   " << std::left << std::setw(38)
+        << ("[" + std::to_string(windows.window_begin()) + ", " + std::to_string(windows.window_end()) + ")")
+        << std::right << " | "
+        << std::setw(20) << weight
+        << " | "
+        << std::setw(12) << std::fixed << std::setprecision(6) << time
+        << " | "
+        << std::setw(12) << windows.num_active_arcs() << " |" << note << "\n";
+}
+
+// streaming mode: solves the first window with algo from scratch and
+// repairs the solution for each further window, only the arcs whose
+// demand changed are passed on to the repair
+void run_windows(MatchingConfig &config, demand_window &windows, matching_algorithm &algo,
+        std::ofstream &window_file) {
+    std::vector<Algora::Arc*> changed;
+    windows.reset();
+    windows.next_window(changed);
+
+    std::cout << "| " << std::left << std::setw(40) << algo.getName() << std::flush;
+    auto result = run_algorithm(algo, config.b);
+    print_result(result);
+    if (!result.prepared) {
+        return;
+    }
+    const auto name = algo.getShortName() + "@";
+    print_window(windows, result.weight, result.time);
+    write_result(config, algo.getThreshold(), name + std::to_string(windows.window_begin()), result);
+    if (window_file.is_open()) {
+        write_window(window_file, windows, algo, algo.getShortName() + " b=" + std::to_string(config.b),
+                result.weight);
+    }
+
+    k_matching_repair repair(config);
+    repair.set_max_vertex_id(windows.getMaxVertexId());
+    repair.setGraph(windows.getDiGraph());
+    repair.setWeights(windows.getArcWeights());
+    repair.set_num_matchings(config.b);
+    repair.set_switch_penalty(config.switch_penalty);
+    repair.adopt(algo);
+
+    ChronoTimer t;
+    auto total_time = 0.0;
+    auto max_time = 0.0;
+    auto switches = 0UL;
+    auto objective = 0LL;
+    while (windows.next_window(changed)) {
+        t.restart();
+        for (auto *arc : changed) {
+            repair.weight_changed(arc);
+        }
+        repair.run();
+        auto time = t.elapsed<>();
+        total_time += time;
+        max_time = std::max(max_time, time);
+
+        result.weight = repair.deliver();
+        result.time = time;
+        result.cpu_time = 0.0;
+        switches += repair.num_switches();
+        objective += repair_objective(result.weight, repair.num_switches(), config.switch_penalty);
+        print_window(windows, result.weight, time, " (" + std::to_string(repair.num_switches()) + " switches)");
+        write_diff(algo.getShortName() + " b=" + std::to_string(config.b) + " window "
+                + std::to_string(windows.window_begin()) + " " + std::to_string(windows.window_end()),
+                repair, [&windows] (unsigned long long id) { return windows.vertex_label(id); });
+        write_result(config, algo.getThreshold(), name + std::to_string(windows.window_begin()), result);
+        if (window_file.is_open()) {
+            write_window(window_file, windows, repair, algo.getShortName() + "+repair b=" + std::to_string(config.b),
+                    result.weight);
+        }
+    }
+
+    std::cout << "| " << std::left << std::setw(40)
+        << ("  + repair of " + std::to_string(windows.num_windows() - 1) + " windows")
+        << std::right << " | "
+        << std::setw(20) << ""
+        << " | "
+        << std::setw(12) << std::fixed << std::setprecision(6) << total_time
+        << " | "
+        << std::setw(12) << max_time
+        << " |\n";
+    std::cout << "|   " << switches << " switches in total";
+    if (config.switch_penalty > 0) {
+        std::cout << ", summed weight minus switching cost " << objective;
+    }
+    std::cout << "\n";
+}
+
+void run_stream(MatchingConfig &config, demand_window &windows,
+        std::vector<std::unique_ptr<matching_algorithm>> &algos) {
+    std::ofstream window_file;
+    if (!config.window_output.empty()) {
+        window_file.open(config.window_output);
+    }
+
+    for (auto &algo : algos) {
+        algo->set_max_vertex_id(windows.getMaxVertexId());
+        algo->setGraph(windows.getDiGraph());
+        algo->setWeights(windows.getArcWeights());
+    }
+
+    for (auto b : config.all_bs) {
+        config.b = b;
+        std::cout << "Streaming windows of length " << config.window_length
+            << " and slide " << config.window_slide << " with b=" << b << ":\n"
+            << "| "
+            << std::left
+            << std::setw(40)
+            << "Algorithm"
+            << " | "
+            << std::right
+            << std::setw(20)
+            << "Weight"
+            << " | "
+            << std::setw(12)
+            << "Time (s)"
+            << " | "
+            << std::setw(12)
+            << "CPU (s)"
+            << " | "
+            << std::setw(12)
+            << "RSS+ (KiB)"
+            << " | "
+            << std::setw(12)
+            << "Alloc (KiB)"
+            << " | "
+            << std::setw(12)
+            << "Allocs"
+            << " |\n"
+            // the rows of print_window() below each algorithm
+            << "|   "
+            << std::left
+            << std::setw(38)
+            << "Window"
+            << " | "
+            << std::right
+            << std::setw(20)
+            << "Weight"
+            << " | "
+            << std::setw(12)
+            << "Time (s)"
+            << " | "
+            << std::setw(12)
+            << "Active arcs"
+            << " |\n";
+        for (auto &algo : algos) {
+            if (algo->modifiesGraph()) {
+                std::cout << "| " << std::left << std::setw(40) << algo->getName()
+                    << " | modifies the graph, not supported in streaming mode\n";
+                continue;
+            }
+            run_windows(config, windows, *algo, window_file);
+        }
+    }
+}
+
+// anytime mode: best solution found by a portfolio of algorithms
+// within config.portfolio_deadline_ms per b
+void run_portfolio(MatchingConfig &config, Algora::DiGraph *graph,
+        Algora::FastPropertyMap<EdgeWeight> *weights, Algora::DiGraph::size_type max_vertex_id,
+        const std::vector<unsigned long> *vertex_ids) {
+    portfolio_solver portfolio(graph, weights, max_vertex_id);
+
+    // fast baselines
+    portfolio.add_baseline(new greedy_iterative(config, false));
+    portfolio.add_baseline(new node_centered(config, AggregateType::B_SUM));
+    // heavier variants
+    portfolio.add_heavy(new greedy_iterative(config, true));
+    portfolio.add_heavy(new kEdgeColoring(config, true, false, false));
+    portfolio.add_heavy(new kEdgeColoring(config, true, true, true));
+    portfolio.add_heavy(new gpa(config, true, false, 0));
+    portfolio.add_heavy(new gpa(config, false, false, config.roma ? config.l : 10));
+
+    const std::chrono::milliseconds budget(config.portfolio_deadline_ms);
+    for (auto b : config.all_bs) {
+        config.b = b;
+        std::cout << "Running portfolio with b=" << b << " and a deadline of "
+            << budget.count() << "ms:\n"
+            << "| "
+            << std::left
+            << std::setw(40)
+            << "Algorithm"
+            << " | "
+            << std::right
+            << std::setw(20)
+            << "Weight"
+            << " | "
+            << std::setw(12)
+            << "Time (s)"
+            << " | "
+            << std::setw(12)
+            << "Status"
+            << " |\n";
+
+        ChronoTimer t;
+        portfolio.solve(b, budget, config.threads);
+        auto time = t.elapsed<>();
 
-            << "\n";
+        for (const auto &run : portfolio.get_runs()) {
+            std::cout << "| " << std::left << std::setw(40) << run.name
+                << std::right << " | "
+                << std::setw(20) << run.weight
+                << " | "
+                << std::setw(12) << std::fixed << std::setprecision(6) << run.time
+                << " | "
+                << std::setw(12) << (run.finished ? "finished" : (run.started ? "cancelled" : "not started"))
+                << " |\n";
+        }
+
+        if (!portfolio.has_solution()) {
+            std::cout << "No algorithm finished within the deadline.\n";
+            continue;
+        }
+        const auto &best = portfolio.best_run();
+        std::cout << "Best solution: " << best.name << " with weight " << portfolio.best_weight()
+            << " after " << time << "s\n";
+        algorithm_result result;
+        result.prepared = true;
+        result.weight = portfolio.best_weight();
+        result.time = time;
+        write_result(config, -1.0, "portfolio:" + best.short_name, result);
+        if (!config.solution_output.empty()) {
+            std::cout << output_solution(config, "portfolio", config.all_bs.size() == 1, vertex_ids,
+                    [&config,&portfolio,graph] (const std::string &filename,
+                        const solution_writer_options &options, std::string &error) {
+                return write_solution(filename, graph, portfolio.best_edge_colors(), portfolio.best_mates(),
+                        config.b, options, error);
+            });
+        }
+    }
+}
+
+// runs GPA for config.gpa_seeds seeds in parallel and reports the
+// distribution of the weights and the best solution
+void run_gpa_seeds(MatchingConfig &config, Algora::DiGraph *graph,
+        Algora::FastPropertyMap<EdgeWeight> *weights, Algora::DiGraph::size_type max_vertex_id,
+        const std::vector<unsigned long> *vertex_ids) {
+    gpa_multi_seed multi(config, config.swaps, config.roma ? config.l : 0);
+    ChronoTimer t;
+    multi.setGraph(graph, weights, max_vertex_id);
+    std::cout << "Sorting " << multi.num_weight_buckets() << " weight buckets took "
+        << t.elapsed<>() << "s\n";
+
+    for (auto b : config.all_bs) {
+        config.b = b;
+        std::cout << "Running " << multi.getName() << " with b=" << b << " for "
+            << config.gpa_seeds << " seeds:\n"
+            << "| "
+            << std::setw(12)
+            << "Seed"
+            << " | "
+            << std::setw(20)
+            << "Weight"
+            << " | "
+            << std::setw(12)
+            << "Time (s)"
+            << " |\n";
+
+        t.restart();
+        multi.solve(b, config.seed, config.gpa_seeds, config.threads);
+        auto time = t.elapsed<>();
+
+        std::vector<EdgeWeight> weights;
+        for (const auto &res : multi.get_results()) {
+            if (!res.prepared) {
+                std::cout << "| " << std::setw(12) << res.seed
+                    << " | " << std::setw(35) << " FAILED TO PREPARE " << " |\n";
+                continue;
+            }
+            std::cout << "| " << std::setw(12) << res.seed
+                << " | " << std::setw(20) << res.weight
+                << " | " << std::setw(12) << std::fixed << std::setprecision(6) << res.time
+                << " |\n";
+            algorithm_result result;
+            result.prepared = true;
+            result.weight = res.weight;
+            result.time = res.time;
+            write_result(config, -1.0, multi.getShortName(), result, res.seed);
+            weights.push_back(res.weight);
+        }
+        if (!multi.has_best()) {
+            std::cout << "No seed could be prepared\n";
+            continue;
+        }
+
+        std::sort(weights.begin(), weights.end());
+        double mean = 0.0;
+        for (auto w : weights) {
+            mean += w;
+        }
+        mean /= weights.size();
+        double variance = 0.0;
+        for (auto w : weights) {
+            variance += (w - mean) * (w - mean);
+        }
+        variance /= weights.size();
+        const auto median = weights.size() % 2 != 0
+            ? static_cast<double>(weights[weights.size() / 2])
+            : (weights[weights.size() / 2 - 1] + weights[weights.size() / 2]) / 2.0;
+
+        std::cout << "Weights: min " << weights.front()
+            << ", median " << std::setprecision(1) << median
+            << ", mean " << mean
+            << ", max " << weights.back()
+            << ", stddev " << std::sqrt(variance) << "\n"
+            << "Best solution: seed " << multi.best().seed << " with weight " << multi.best().weight
+            << ", all seeds took " << std::setprecision(6) << time << "s\n";
+        if (!config.solution_output.empty()) {
+            std::cout << output_solution(config, multi.getShortName(), config.all_bs.size() == 1, vertex_ids,
+                    [&config,&multi,graph] (const std::string &filename,
+                        const solution_writer_options &options, std::string &error) {
+                return write_solution(filename, graph, multi.best_edge_colors(), multi.best_mates(),
+                        config.b, options, error);
+            });
+        }
     }
 }
 
@@ -59,6 +830,12 @@ int main(int argc, char **argv) {
         return 0;
     }
 
+    trace_writer trace{config.trace_output};
+    if (!config.trace_output.empty()) {
+        TraceRecorder::instance().enable();
+        TraceRecorder::instance().name_thread("main");
+    }
+
     std::ifstream graph_file;
     graph_file.open(graph_filename);
 
@@ -81,169 +858,143 @@ int main(int argc, char **argv) {
     ChronoTimer t;
 
     Algora::DynamicWeightedDiGraph<unsigned long> G(0);
-    Algora::KonectNetworkReader reader;
-    reader.setInputStream(&graph_file);
-    reader.provideDynamicWeightedDiGraph(&G);
-    graph_file.close();
-    std::cout << "Input I/O took " << t.elapsed() << "s\n";
-    std::cout << "%n,m " << G.getConstructedGraphSize() << "," << G.getConstructedArcSize() << "\n";
+    std::unique_ptr<demand_window> windows;
+    {
+    DJM_TRACE("load");
+    if (config.window_length > 0) {
+        windows.reset(new demand_window(config.window_length, config.window_slide));
+        std::string error;
+        if (!windows->read(graph_file, error)) {
+            std::cout << "Error! Could not read " << graph_filename << ": " << error << "\n";
+            return 1;
+        }
+        graph_file.close();
+        std::cout << "Input I/O took " << t.elapsed() << "s\n";
+        std::cout << "%n,m " << windows->getDiGraph()->getSize() << ","
+            << windows->getDiGraph()->getNumArcs(true) << "\n";
+        std::cout << "%records " << windows->num_records() << "\n";
+    } else {
+        Algora::KonectNetworkReader reader;
+        reader.setInputStream(&graph_file);
+        reader.provideDynamicWeightedDiGraph(&G);
+        graph_file.close();
+        std::cout << "Input I/O took " << t.elapsed() << "s\n";
+        std::cout << "%n,m " << G.getConstructedGraphSize() << "," << G.getConstructedArcSize() << "\n";
+    }
+    }
+
+    // graph the algorithms run on: the first delta of the input or its
+    // normalized copy, which is static
+    std::unique_ptr<normalized_graph> normalized;
+    if (config.normalize != NO_NORMALIZE) {
+        DJM_TRACE("normalize");
+        G.resetToBigBang();
+        G.applyNextDelta();
+        ChronoTimer normalize_t;
+        normalized.reset(new normalized_graph(config.normalize, config.vertex_order));
+        normalized->build(G.getDiGraph(), G.getArcWeights(), G.getMaxVertexId(), config.threads);
+        std::cout << "Normalization took " << normalize_t.elapsed() << "s\n";
+        std::cout << "%normalized m " << normalized->getDiGraph()->getNumArcs(true)
+            << ", merged " << normalized->num_merged_arcs()
+            << ", dropped " << normalized->num_dropped_arcs() << "\n";
+    }
+    Algora::DiGraph *diGraph = normalized ? normalized->getDiGraph() : G.getDiGraph();
+    auto *weights = normalized ? normalized->getArcWeights() : G.getArcWeights();
+    const auto max_vertex_id = normalized ? normalized->getMaxVertexId() : G.getMaxVertexId();
+    // input vertex id per vertex id if the vertices were reordered
+    const auto *vertex_ids = normalized ? normalized->input_ids() : nullptr;
+    // undoes all changes to the graph of earlier runs
+    auto restore_graph = [&G,&normalized] () {
+        if (!normalized) {
+            G.resetToBigBang();
+            G.applyNextDelta();
+        }
+    };
+
+    if (!config.diff_output.empty()) {
+        difffile.open(config.diff_output);
+    }
+
+    std::vector<solution_link> warm_start;
+    if (!config.warm_start_file.empty()) {
+        std::ifstream warm_start_file(config.warm_start_file);
+        std::string error;
+        if (!warm_start_file.is_open()) {
+            std::cout << "Error! Could not open file " << config.warm_start_file << "\n";
+            return 1;
+        }
+        if (!read_solution(warm_start_file, warm_start, error)) {
+            std::cout << "Error! Could not read " << config.warm_start_file << ": " << error << "\n";
+            return 1;
+        }
+        std::cout << "%warm start links " << warm_start.size() << "\n";
+        if (vertex_ids) {
+            for (auto &link : warm_start) {
+                if (link.tail < max_vertex_id && link.head < max_vertex_id) {
+                    link.tail = normalized->relabeled_id(link.tail);
+                    link.head = normalized->relabeled_id(link.head);
+                }
+            }
+        }
+    }
 
     if (config.writeOutputfile) {
         bool nfile = !file_exists(config.outputFile);
 
         outfile.open(config.outputFile, std::ios::app | std::ios::out);
         if (nfile) {
-            outfile << "graph,b,seed,l,threshold_global,algorithm,time,weight\n";
+            outfile << RESULTS_CSV_HEADER;
         }
     }
 
-    if (config.all_bs.empty()) {
-        config.all_bs.push_back(1);
-    }
+    if (!config.phase_output.empty()) {
+        bool nfile = !file_exists(config.phase_output);
 
-    std::vector<std::unique_ptr<matching_algorithm>> algos;
+        phasefile.open(config.phase_output, std::ios::app | std::ios::out);
+        if (nfile) {
+            phasefile << "graph,b,seed,algorithm,phase,depth,time,count,"
+                "cycles,instructions,llc_misses,dtlb_misses,branch_misses\n";
+        }
+    }
 
-    if (config.greedy) {
-        const bool swaps = true;
-        algos.emplace_back(new greedy_b_matching(config));
+    // concurrent runs only see their own allocations, but share the peak RSS
+    process_wide_allocations = config.parallel_algorithms == 1;
 
-        if (config.swaps_and_normal) {
-            algos.emplace_back(new greedy_iterative(config, swaps, true));
-            algos.emplace_back(new greedy_iterative(config, swaps, false));
-            algos.emplace_back(new greedy_iterative(config, !swaps));
+    if (config.perf_counters) {
+        PerfCounters probe;
+        if (!probe.available()) {
+            std::cout << "Hardware counters unavailable (" << probe.get_error() << "), reporting times only.\n";
         } else {
-            if (config.swaps) {
-                algos.emplace_back(new greedy_iterative(config, config.swaps, true));
+            if (!probe.get_error().empty()) {
+                std::cout << "Some hardware counters unavailable (" << probe.get_error() << ").\n";
             }
-            algos.emplace_back(new greedy_iterative(config, config.swaps));
+            collect_perf_counters = true;
         }
     }
 
-    if (config.node_centered) {
-        const bool threshold = true;
-        // node centered with threshold active
-        algos.emplace_back(new node_centered(config, AggregateType::MAX, threshold));
-        algos.emplace_back(new node_centered(config, AggregateType::SUM, threshold));
-        algos.emplace_back(new node_centered(config, AggregateType::B_SUM, threshold));
-
-        // node centered without threshold
-        algos.emplace_back(new node_centered(config, AggregateType::MAX, !threshold));
-        algos.emplace_back(new node_centered(config, AggregateType::SUM, !threshold));
-        algos.emplace_back(new node_centered(config, AggregateType::B_SUM, !threshold));
+    if (config.all_bs.empty()) {
+        config.all_bs.push_back(1);
     }
 
-    if (config.gpa) {
-        if (config.swaps_and_normal) {
-            algos.emplace_back(new gpa(config, false, false, false));
-            algos.emplace_back(new gpa(config, true, false, false));
-            algos.emplace_back(new gpa(config, false, true, false));
-            algos.emplace_back(new gpa(config, false, false, true));
+    if (config.portfolio_deadline_ms > 0 || config.gpa_seeds > 0) {
+        if (config.portfolio_deadline_ms > 0) {
+            restore_graph();
+            run_portfolio(config, diGraph, weights, max_vertex_id, vertex_ids);
         } else {
-            if (config.swaps) {
-                algos.emplace_back(new gpa(config, config.swaps, false, config.roma));
-                algos.emplace_back(new gpa(config, config.swaps, true, config.roma));
-            }
-            algos.emplace_back(new gpa(config, config.swaps, config.swaps_global, config.roma));
+            restore_graph();
+            run_gpa_seeds(config, diGraph, weights, max_vertex_id, vertex_ids);
         }
+        if (config.writeOutputfile) {
+            outfile.close();
+        }
+        return 0;
     }
 
-    if (!config.algorithms.empty()) {
-        algos.clear();
-        for (const auto &algorithm : config.algorithms) {
-            switch(algorithm) {
-                case MatchingAlgorithm::BGREEDY_COLOR:
-                    if (config.swaps_and_normal) {
-                        algos.emplace_back(new greedy_b_matching(config, false, false));
-                        algos.emplace_back(new greedy_b_matching(config, false, true));
-                    } else {
-                        algos.emplace_back(new greedy_b_matching(config, false, config.swaps_global));
-                    }
-                    break;
-                case MatchingAlgorithm::BGREEDY_EXTEND:
-                    if (config.swaps_and_normal) {
-                        algos.emplace_back(new greedy_b_matching(config, true, false));
-                        algos.emplace_back(new greedy_b_matching(config, true, true));
-                    } else {
-                        algos.emplace_back(new greedy_b_matching(config, true, config.swaps_global));
-                    }
-                    break;
-                case MatchingAlgorithm::GREEDY_IT:
-                    if (config.swaps_and_normal) {
-                        algos.emplace_back(new greedy_iterative(config, false, config.swaps_global));
-                        if (config.swaps_global) {
-                            algos.emplace_back(new greedy_iterative(config, true, false));
-                        }
-                        algos.emplace_back(new greedy_iterative(config, true, config.swaps_global));
-                    } else {
-                        algos.emplace_back(new greedy_iterative(config, config.swaps, config.swaps_global));
-                    }
-                    break;
-                case MatchingAlgorithm::NODE_CENTERED:
-                    if (config.aggregation_types.empty()) {
-                        std::cerr << "Error: trying to run node-centered without any aggregation type set\n";
-                        return 1;
-                    }
-                    for (const auto &atype : config.aggregation_types) {
-                        if (config.global_thresholds.empty()) {
-                            algos.emplace_back(new node_centered(config, atype));
-                        } else {
-                            for (const auto &thresh : config.global_thresholds) {
-                                algos.emplace_back(new node_centered(config, atype, thresh));
-                            }
-                        }
-                    }
-                    break;
-                case MatchingAlgorithm::GPA_IT:
-                    if (config.swaps_and_normal) {
-                        // normal
-                        algos.emplace_back(new gpa(config, false, config.swaps_global, 0));
-                        if (config.swaps_global) {
-                            // if global, add local
-                            algos.emplace_back(new gpa(config, true, false, 0));
-                        }
-                        // global if enabled, else local
-                        algos.emplace_back(new gpa(config, true, config.swaps_global, 0));
-                        if (config.roma) {
-                            algos.emplace_back(new gpa(config, false, config.swaps_global, config.l));
-                        }
-                    } else if (config.swaps) {
-                        algos.emplace_back(new gpa(config, config.swaps, config.swaps_global, 0));
-                        if (config.roma) {
-                            algos.emplace_back(new gpa(config, false, false, config.l));
-                        }
-                    } else {
-                        algos.emplace_back(new gpa(config, config.swaps, config.swaps_global, config.l));
-                    }
-                    break;
-                case MatchingAlgorithm::K_EC:
-                    if (config.swaps_and_normal) {
-                        // normal
-                        algos.emplace_back(new kEdgeColoring(config, false, false, false));
-                        algos.emplace_back(new kEdgeColoring(config, true, false, false));
-                        algos.emplace_back(new kEdgeColoring(config, false, false, true));
-                        algos.emplace_back(new kEdgeColoring(config, true, false, true));
-                        // global swaps
-                        algos.emplace_back(new kEdgeColoring(config, false, true, false));
-                        algos.emplace_back(new kEdgeColoring(config, true, true, false));
-                        algos.emplace_back(new kEdgeColoring(config, false, true, true));
-                        algos.emplace_back(new kEdgeColoring(config, true, true, true));
-                    } else if (config.swaps) {
-                        algos.emplace_back(new kEdgeColoring(config, false, true, false));
-                        algos.emplace_back(new kEdgeColoring(config, true, true, false));
-                        algos.emplace_back(new kEdgeColoring(config, false, true, true));
-                        algos.emplace_back(new kEdgeColoring(config, true, true, true));
-                    } else {
-                        algos.emplace_back(new kEdgeColoring(config, false, false, false));
-                        algos.emplace_back(new kEdgeColoring(config, true, false, false));
-                        algos.emplace_back(new kEdgeColoring(config, false, false, true));
-                        algos.emplace_back(new kEdgeColoring(config, true, false, true));
-                    }
-                    break;
-                default:
-                    std::cerr << "Error: invalid algorithm passed " << algorithm << "\n";
-                    return 1;
-            }
-        }
+    algorithm_list algos;
+    std::string algorithms_error;
+    if (!create_algorithms(config, algos, algorithms_error)) {
+        std::cerr << "Error: " << algorithms_error << "\n";
+        return 1;
     }
 
     if (config.algorithm_order_seed != 0) {
@@ -252,16 +1003,100 @@ int main(int argc, char **argv) {
         std::shuffle(algos.begin(), algos.end(), rng);
     }
 
-    auto *diGraph = G.getDiGraph();
-    auto *weights = G.getArcWeights();
+    if (config.components) {
+        for (auto &algo : algos) {
+            auto *prototype = algo->clone();
+            if (prototype == nullptr) {
+                std::cout << "Warning: " << algo->getName() << " can't be run per component, solving the whole graph\n";
+                continue;
+            }
+            delete prototype;
+            algo.reset(new component_solver(config, algo.release()));
+        }
+    }
+
+    if (windows) {
+        run_stream(config, *windows, algos);
+        if (config.writeOutputfile) {
+            outfile.close();
+        }
+        return 0;
+    }
+
     for (auto & algo : algos) {
-        algo->set_max_vertex_id(G.getMaxVertexId());
+        algo->set_max_vertex_id(max_vertex_id);
         algo->setGraph(diGraph);
         algo->setWeights(weights);
+        if (!warm_start.empty()) {
+            algo->set_warm_start(&warm_start);
+        }
     }
 
-    for (auto b : config.all_bs) {
+    std::unique_ptr<matching_stream> stream;
+    if (!config.stream_matchings.empty()) {
+        stream.reset(new matching_stream(config.stream_matchings));
+        stream->set_vertex_ids(vertex_ids);
+        if (!stream->is_open()) {
+            std::cout << "Error! Could not open file " << config.stream_matchings << "\n";
+            return 1;
+        }
+    }
+
+    // upper bounds on the optimum, gathered before any algorithm modifies the graph
+    std::unique_ptr<upper_bounds> bounds;
+    if (config.upper_bounds) {
+        DJM_TRACE("upper bounds");
+        ChronoTimer bounds_t;
+        bounds.reset(new upper_bounds(diGraph, *weights, max_vertex_id, config.threads));
+        std::cout << "Prepared upper bounds in " << std::fixed << std::setprecision(6)
+            << bounds_t.elapsed() << "s\n";
+    }
+
+    // results for all b of algorithms that compute matchings incrementally
+    std::vector<std::vector<algorithm_result>> prefix_results(algos.size());
+    std::vector<std::vector<std::string>> prefix_notes(algos.size());
+    const bool single_solution = algos.size() == 1 && config.all_bs.size() == 1;
+    if (config.incremental_b && config.all_bs.size() > 1 && warm_start.empty()) {
+        config.b = *std::max_element(config.all_bs.begin(), config.all_bs.end());
+        for (auto a = 0UL; a < algos.size(); a++) {
+            if (algos[a]->computesMatchingsIncrementally()) {
+                restore_graph();
+                prefix_results[a] = run_algorithm_prefixes(*algos[a], config.all_bs);
+                // the solution for the largest b contains those for all b
+                prefix_notes[a].resize(config.all_bs.size());
+                if (!config.solution_output.empty()) {
+                    const auto max_b = config.b;
+                    for (auto b_index = 0UL; b_index < config.all_bs.size(); b_index++) {
+                        config.b = config.all_bs[b_index];
+                        if (prefix_results[a][b_index].prepared) {
+                            prefix_notes[a][b_index] = output_solution(config, *algos[a], diGraph, single_solution, vertex_ids);
+                        }
+                    }
+                    config.b = max_b;
+                }
+                std::cout << "Computed all b at once with b=" << config.b << " for " << algos[a]->getName() << "\n";
+            }
+        }
+    }
+
+    for (auto b_index = 0UL; b_index < config.all_bs.size(); b_index++) {
+        const auto b = config.all_bs[b_index];
         config.b = b;
+        EdgeWeight top_b_bound = 0;
+        EdgeWeight fractional_bound = 0;
+        if (bounds) {
+            DJM_TRACE("upper bounds");
+            ChronoTimer bounds_t;
+            top_b_bound = bounds->top_b(b);
+            fractional_bound = bounds->fractional(b);
+            std::cout << "Upper bounds with b=" << b << ": " << top_b_bound << " (top-b), "
+                << fractional_bound << " (fractional), computed in " << std::fixed << std::setprecision(6)
+                << bounds_t.elapsed() << "s\n";
+        }
+        auto add_bounds = [top_b_bound,fractional_bound] (algorithm_result &result) {
+            result.top_b_bound = top_b_bound;
+            result.fractional_bound = fractional_bound;
+        };
         std::cout << "Running with b=" << b << ":\n"
             << "| "
             << std::left
@@ -274,34 +1109,153 @@ int main(int argc, char **argv) {
             << " | "
             << std::setw(12)
             << "Time (s)"
-            << " |\n";
+            << " | "
+            << std::setw(12)
+            << "CPU (s)"
+            << " | "
+            << std::setw(12)
+            << "RSS+ (KiB)"
+            << " | "
+            << std::setw(12)
+            << "Alloc (KiB)"
+            << " | "
+            << std::setw(12)
+            << "Allocs";
+        if (bounds) {
+            std::cout << " | " << std::setw(10) << "Of bound";
+        }
+        std::cout << " |\n";
         std::locale loc("");
         std::cout.imbue(loc);
-        for (auto & algo : algos) {
-            G.resetToBigBang();
-            G.applyNextDelta();
-            algo->set_num_matchings(config.b);
-            std::cout << "| " << std::left << std::setw(40) << algo->getName() << std::flush;
-            if (!algo->prepare()) {
-                std::cout  << std::right << " | "
-                    << std::setw(35)
-                    << " FAILED TO PREPARE "
-                    << " |\n";
-                continue;
+        if (config.parallel_algorithms == 1) {
+            for (auto a = 0UL; a < algos.size(); a++) {
+                auto &algo = algos[a];
+                if (!prefix_results[a].empty()) {
+                    std::cout << "| " << std::left << std::setw(40) << algo->getName();
+                    auto &result = prefix_results[a][b_index];
+                    add_bounds(result);
+                    if (result.prepared) {
+                        write_result(config, *algo, result);
+                    }
+                    print_result(result);
+                    std::cout << prefix_notes[a][b_index];
+                    continue;
+                }
+                restore_graph();
+                std::cout << "| " << std::left << std::setw(40) << algo->getName() << std::flush;
+                if (stream) {
+                    stream->attach(*algo, diGraph, weights, config.b,
+                            algo->getShortName() + " b=" + std::to_string(config.b));
+                }
+                auto result = run_algorithm(*algo, config.b);
+                add_bounds(result);
+                if (stream) {
+                    if (result.prepared) {
+                        stream->detach();
+                    } else {
+                        algo->set_matching_listener(nullptr);
+                    }
+                }
+                if (result.prepared) {
+                    write_result(config, *algo, result);
+                    write_phases(config, *algo);
+                }
+                print_result(result);
+                if (config.phase_times && result.prepared) {
+                    std::cout << phase_summary(*algo, result);
+                }
+                if (config.event_counters && result.prepared) {
+                    std::cout << event_summary(*algo);
+                }
+                if (!warm_start.empty() && result.prepared) {
+                    std::cout << warm_start_summary(warm_start, *algo, diGraph);
+                }
+                if (config.components && result.prepared) {
+                    if (auto solver = dynamic_cast<component_solver*>(algo.get())) {
+                        std::cout << component_summary(config, *solver);
+                    }
+                }
+                if (!config.solution_output.empty() && result.prepared) {
+                    std::cout << output_solution(config, *algo, diGraph, single_solution, vertex_ids);
+                }
+                if (config.dynamic && result.prepared) {
+                    run_dynamic(config, G, *algo);
+                }
             }
-            t.restart();
-            algo->run();
-            auto time = t.elapsed<>();
-            auto res = algo->deliver();
-            write_result(config, *algo, time, res);
-            std::cout  << std::right << " | "
-                << std::setw(20)
-                << res
-                << " | "
-                << std::setw(12)
-                << std::fixed << std::setprecision(6)
-                << time
-                << " |\n";
+        } else {
+            // algorithms that only read the graph run concurrently,
+            // those that modify it one after another afterwards
+            std::vector<algorithm_result> results(algos.size());
+            std::vector<std::string> result_notes(algos.size());
+            std::vector<size_t> shared_graph;
+            std::vector<size_t> exclusive_graph;
+            for (auto i = 0UL; i < algos.size(); i++) {
+                if (algos[i]->modifiesGraph()) {
+                    exclusive_graph.push_back(i);
+                } else {
+                    shared_graph.push_back(i);
+                }
+            }
+
+            ChronoTimer batch_t;
+            restore_graph();
+            reset_peak_rss();
+            parallel_for(shared_graph.size(), config.parallel_algorithms, [&] (size_t i) {
+                auto a = shared_graph[i];
+                results[a] = run_algorithm(*algos[a], config.b);
+                if (!warm_start.empty() && results[a].prepared) {
+                    result_notes[a] = warm_start_summary(warm_start, *algos[a], diGraph);
+                }
+                if (config.components && results[a].prepared) {
+                    if (auto solver = dynamic_cast<component_solver*>(algos[a].get())) {
+                        result_notes[a] += component_summary(config, *solver);
+                    }
+                }
+            });
+            // the writer is parallel itself, so write after the join and
+            // before the graph is restored for the other algorithms
+            if (!config.solution_output.empty()) {
+                for (auto a : shared_graph) {
+                    if (results[a].prepared) {
+                        result_notes[a] += output_solution(config, *algos[a], diGraph, single_solution, vertex_ids);
+                    }
+                }
+            }
+            for (auto a : exclusive_graph) {
+                restore_graph();
+                results[a] = run_algorithm(*algos[a], config.b);
+                if (!warm_start.empty() && results[a].prepared) {
+                    result_notes[a] = warm_start_summary(warm_start, *algos[a], diGraph);
+                }
+                if (config.components && results[a].prepared) {
+                    if (auto solver = dynamic_cast<component_solver*>(algos[a].get())) {
+                        result_notes[a] += component_summary(config, *solver);
+                    }
+                }
+                if (!config.solution_output.empty() && results[a].prepared) {
+                    result_notes[a] += output_solution(config, *algos[a], diGraph, single_solution, vertex_ids);
+                }
+            }
+            auto batch_time = batch_t.elapsed<>();
+
+            for (auto i = 0UL; i < algos.size(); i++) {
+                std::cout << "| " << std::left << std::setw(40) << algos[i]->getName();
+                add_bounds(results[i]);
+                if (results[i].prepared) {
+                    write_result(config, *algos[i], results[i]);
+                    write_phases(config, *algos[i]);
+                }
+                print_result(results[i]);
+                if (config.phase_times && results[i].prepared) {
+                    std::cout << phase_summary(*algos[i], results[i]);
+                }
+                if (config.event_counters && results[i].prepared) {
+                    std::cout << event_summary(*algos[i]);
+                }
+                std::cout << result_notes[i];
+            }
+            std::cout << "Wall time for all algorithms: " << std::fixed << std::setprecision(6)
+                << batch_time << "s\n";
         }
     }
 
@@ -0,0 +1,194 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "matching/algorithm_factory.h"
+
+#include "matching/greedy_b_matching.h"
+#include "matching/greedy_iterative.h"
+#include "matching/node_centered.h"
+#include "matching/gpa/gpa.h"
+#include "matching/coloring/k_edge_coloring.hpp"
+
+bool create_algorithms(MatchingConfig &config, algorithm_list &algos, std::string &error) {
+    if (config.greedy) {
+        const bool swaps = true;
+        algos.emplace_back(new greedy_b_matching(config));
+
+        if (config.swaps_and_normal) {
+            algos.emplace_back(new greedy_iterative(config, swaps, true));
+            algos.emplace_back(new greedy_iterative(config, swaps, false));
+            algos.emplace_back(new greedy_iterative(config, !swaps));
+        } else {
+            if (config.swaps) {
+                algos.emplace_back(new greedy_iterative(config, config.swaps, true));
+            }
+            algos.emplace_back(new greedy_iterative(config, config.swaps));
+        }
+    }
+
+    if (config.node_centered) {
+        const bool threshold = true;
+        // node centered with threshold active
+        algos.emplace_back(new node_centered(config, AggregateType::MAX, threshold));
+        algos.emplace_back(new node_centered(config, AggregateType::SUM, threshold));
+        algos.emplace_back(new node_centered(config, AggregateType::B_SUM, threshold));
+
+        // node centered without threshold
+        algos.emplace_back(new node_centered(config, AggregateType::MAX, !threshold));
+        algos.emplace_back(new node_centered(config, AggregateType::SUM, !threshold));
+        algos.emplace_back(new node_centered(config, AggregateType::B_SUM, !threshold));
+    }
+
+    if (config.gpa) {
+        if (config.swaps_and_normal) {
+            algos.emplace_back(new gpa(config, false, false, false));
+            algos.emplace_back(new gpa(config, true, false, false));
+            algos.emplace_back(new gpa(config, false, true, false));
+            algos.emplace_back(new gpa(config, false, false, true));
+        } else {
+            if (config.swaps) {
+                algos.emplace_back(new gpa(config, config.swaps, false, config.roma));
+                algos.emplace_back(new gpa(config, config.swaps, true, config.roma));
+            }
+            algos.emplace_back(new gpa(config, config.swaps, config.swaps_global, config.roma));
+        }
+    }
+
+    if (!config.algorithms.empty()) {
+        algos.clear();
+        for (const auto &algorithm : config.algorithms) {
+            switch(algorithm) {
+                case MatchingAlgorithm::BGREEDY_COLOR:
+                    if (config.swaps_and_normal) {
+                        algos.emplace_back(new greedy_b_matching(config, false, false));
+                        algos.emplace_back(new greedy_b_matching(config, false, true));
+                    } else {
+                        algos.emplace_back(new greedy_b_matching(config, false, config.swaps_global));
+                    }
+                    break;
+                case MatchingAlgorithm::BGREEDY_EXTEND:
+                    if (config.swaps_and_normal) {
+                        algos.emplace_back(new greedy_b_matching(config, true, false));
+                        algos.emplace_back(new greedy_b_matching(config, true, true));
+                    } else {
+                        algos.emplace_back(new greedy_b_matching(config, true, config.swaps_global));
+                    }
+                    break;
+                case MatchingAlgorithm::GREEDY_IT:
+                    if (config.swaps_and_normal) {
+                        algos.emplace_back(new greedy_iterative(config, false, config.swaps_global));
+                        if (config.swaps_global) {
+                            algos.emplace_back(new greedy_iterative(config, true, false));
+                        }
+                        algos.emplace_back(new greedy_iterative(config, true, config.swaps_global));
+                    } else {
+                        algos.emplace_back(new greedy_iterative(config, config.swaps, config.swaps_global));
+                    }
+                    break;
+                case MatchingAlgorithm::NODE_CENTERED:
+                    if (config.aggregation_types.empty()) {
+                        error = "trying to run node-centered without any aggregation type set";
+                        return false;
+                    }
+                    for (const auto &atype : config.aggregation_types) {
+                        if (config.global_thresholds.empty()) {
+                            algos.emplace_back(new node_centered(config, atype));
+                        } else {
+                            for (const auto &thresh : config.global_thresholds) {
+                                algos.emplace_back(new node_centered(config, atype, thresh));
+                            }
+                        }
+                    }
+                    break;
+                case MatchingAlgorithm::GPA_IT:
+                    if (config.swaps_and_normal) {
+                        // normal
+                        algos.emplace_back(new gpa(config, false, config.swaps_global, 0));
+                        if (config.swaps_global) {
+                            // if global, add local
+                            algos.emplace_back(new gpa(config, true, false, 0));
+                        }
+                        // global if enabled, else local
+                        algos.emplace_back(new gpa(config, true, config.swaps_global, 0));
+                        if (config.roma) {
+                            algos.emplace_back(new gpa(config, false, config.swaps_global, config.l));
+                        }
+                    } else if (config.swaps) {
+                        algos.emplace_back(new gpa(config, config.swaps, config.swaps_global, 0));
+                        if (config.roma) {
+                            algos.emplace_back(new gpa(config, false, false, config.l));
+                        }
+                    } else {
+                        algos.emplace_back(new gpa(config, config.swaps, config.swaps_global, config.l));
+                    }
+                    break;
+                case MatchingAlgorithm::K_EC:
+                    if (config.swaps_and_normal) {
+                        // normal
+                        algos.emplace_back(new kEdgeColoring(config, false, false, false));
+                        algos.emplace_back(new kEdgeColoring(config, true, false, false));
+                        algos.emplace_back(new kEdgeColoring(config, false, false, true));
+                        algos.emplace_back(new kEdgeColoring(config, true, false, true));
+                        // global swaps
+                        algos.emplace_back(new kEdgeColoring(config, false, true, false));
+                        algos.emplace_back(new kEdgeColoring(config, true, true, false));
+                        algos.emplace_back(new kEdgeColoring(config, false, true, true));
+                        algos.emplace_back(new kEdgeColoring(config, true, true, true));
+                    } else if (config.swaps) {
+                        algos.emplace_back(new kEdgeColoring(config, false, true, false));
+                        algos.emplace_back(new kEdgeColoring(config, true, true, false));
+                        algos.emplace_back(new kEdgeColoring(config, false, true, true));
+                        algos.emplace_back(new kEdgeColoring(config, true, true, true));
+                    } else {
+                        algos.emplace_back(new kEdgeColoring(config, false, false, false));
+                        algos.emplace_back(new kEdgeColoring(config, true, false, false));
+                        algos.emplace_back(new kEdgeColoring(config, false, false, true));
+                        algos.emplace_back(new kEdgeColoring(config, true, false, true));
+                    }
+                    break;
+                default:
+                    error = "invalid algorithm passed " + std::to_string(algorithm);
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+void create_all_algorithms(MatchingConfig &config, algorithm_list &algos) {
+    for (auto extend : {false, true}) {
+        for (auto global_swaps : {false, true}) {
+            algos.emplace_back(new greedy_b_matching(config, extend, global_swaps));
+        }
+    }
+
+    algos.emplace_back(new greedy_iterative(config, false));
+    algos.emplace_back(new greedy_iterative(config, true, false));
+    algos.emplace_back(new greedy_iterative(config, true, true));
+
+    for (auto atype : {AggregateType::SUM, AggregateType::MAX, AggregateType::AVG,
+            AggregateType::MEDIAN, AggregateType::B_SUM}) {
+        algos.emplace_back(new node_centered(config, atype));
+        for (const auto &thresh : config.global_thresholds) {
+            algos.emplace_back(new node_centered(config, atype, thresh));
+        }
+    }
+
+    algos.emplace_back(new gpa(config, false, false, 0));
+    algos.emplace_back(new gpa(config, true, false, 0));
+    algos.emplace_back(new gpa(config, true, true, 0));
+    if (config.l > 0) {
+        algos.emplace_back(new gpa(config, false, false, config.l));
+    }
+
+    for (auto lightest_color : {false, true}) {
+        for (auto rotate_long : {false, true}) {
+            for (auto common_color : {false, true}) {
+                algos.emplace_back(new kEdgeColoring(config, common_color, lightest_color, rotate_long));
+            }
+        }
+    }
+}
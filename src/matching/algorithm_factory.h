@@ -0,0 +1,24 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "matching/matching_algorithm.h"
+
+using algorithm_list = std::vector<std::unique_ptr<matching_algorithm>>;
+
+// fills algos with the algorithms selected by the options in config;
+// returns false and sets error if the selection is invalid
+bool create_algorithms(MatchingConfig &config, algorithm_list &algos, std::string &error);
+
+// appends every variant of every algorithm to algos: all combinations
+// of swaps, extension and coloring options, Node-Centered with each
+// aggregation type with and without the thresholds in
+// config.global_thresholds, and GPA with ROMA for config.l > 0
+void create_all_algorithms(MatchingConfig &config, algorithm_list &algos);
@@ -43,13 +43,31 @@ public:
         reset();
         matched.resetAll(diGraph->getSize());
         if (use_lightest_color) {
-            color_weights.resize(num_matchings, 0);
+            color_weights.assign(num_matchings, 0);
             colors_by_weight.reserve(num_matchings);
             colors_by_weight.clear();
             for (auto i = 0U; i < num_matchings; i++) {
                 colors_by_weight.push_back(i);
             }
         }
+        // arcs colored by a warm start
+        if (num_warm_start_arcs() > 0) {
+            diGraph->mapArcs([this] (Arc *a) {
+                const auto c = edge_color(a);
+                if (c != UNCOLORED) {
+                    matched[a->getTail()]++;
+                    matched[a->getHead()]++;
+                    if (use_lightest_color) {
+                        color_weights[c] += (*weights)(a);
+                    }
+                }
+            });
+            if (use_lightest_color) {
+                std::sort(colors_by_weight.begin(), colors_by_weight.end(), [this] (color_t lop, color_t rop) {
+                    return color_weights[lop] < color_weights[rop];
+                });
+            }
+        }
         return true;
      }
 
@@ -57,6 +75,15 @@ public:
          num_colors = edge_coloring();
      }
 
+     virtual matching_algorithm *clone() const override {
+         return new kEdgeColoring(config, find_common_color, use_lightest_color, rotate_long);
+     }
+
+     // seeded arcs keep their color unless recolored by fans and cd-paths
+     virtual bool supportsWarmStart() const noexcept override {
+         return true;
+     }
+
 	virtual std::string getName() const noexcept override {
         return rotate_long
             ?  (find_common_color
@@ -89,10 +116,14 @@ public:
         return num_colors;
     }
 
-private:
+protected:
     color_t num_colors { 0 };
     FastPropertyMap<color_t> matched { 0 };
 
+    // per colored arc, too fine-grained for phases
+    enum coloring_step { FAN_STEP, CD_PATH_STEP, ROTATE_STEP };
+    StepTimes steps { { "fan", "cd-path", "rotate" } };
+
     std::vector<EdgeWeight> color_weights;
     std::vector<color_t> colors_by_weight;
 
@@ -313,13 +344,16 @@ private:
         }, [&stop](const Arc*) { return stop; });
     }
 
-    void invert_cd_path_it(Vertex *x, const color_t &c, const color_t &d)
+    // returns the length of the path
+    unsigned long long invert_cd_path_it(Vertex *x, const color_t &c, const color_t &d)
     {
         auto arcToRecolor = arcToMate[d][x];
         auto nextColor = c;
         auto nextArc = arcToRecolor;
+        auto length = 0ULL;
 
         while (arcToRecolor) {
+            length++;
             x = arcToRecolor->getOther(x);
             nextArc = arcToMate[nextColor][x];
 
@@ -329,6 +363,7 @@ private:
             arcToRecolor = nextArc;
             nextColor = nextColor == c ? d : c;
         }
+        return length;
     }
 
     void rotate_fan(
@@ -362,10 +397,14 @@ private:
             return UNCOLORED;
         }
 
-        //auto fan = maximal_fan(x, xy);
-        //auto fan = small_fan(x, xy);
-        auto fan = quicker_fan(x, xy);
+        std::vector<Arc*> fan;
+        DJM_STEP_START(steps);
+        //fan = maximal_fan(x, xy);
+        //fan = small_fan(x, xy);
+        fan = quicker_fan(x, xy);
+        DJM_STEP_LAP(steps, FAN_STEP);
         assert(fan.size() > 0);
+        events.sample(event_type::FAN_SIZE, fan.size());
 
         color_t d = find_free_color(fan.back()->getOther(x));
 
@@ -377,7 +416,8 @@ private:
         if (!rotate_long || !is_free_color(x, d)) {
             if (c != d) {
             //invert_cd_path(x, c, d);
-                invert_cd_path_it(x, c, d);
+                events.sample(event_type::CD_PATH_LENGTH, invert_cd_path_it(x, c, d));
+                DJM_STEP_LAP(steps, CD_PATH_STEP);
             }
 
             auto w = std::find_if(fan.begin(), fan.end(),
@@ -389,6 +429,7 @@ private:
             rotate_fan(fan.begin(), fan.end());
             set_edge_color(fan.back(), d);
         }
+        DJM_STEP_LAP(steps, ROTATE_STEP);
         return (std::max)(c, d);
     }
 
@@ -397,22 +438,40 @@ private:
         color_t colors = 0;
 
             std::vector<Arc*> edges;
+            // the sort takes O(m log m), so the deadline is checked before
+            // it and, as the first cancellation point of the loop, after it
+            if (stop_requested()) {
+                return colors;
+            }
+            {
+            DJM_TRACED_PHASE(phase_times, "sort");
             edges.reserve(diGraph->getNumArcs(false));
 
-            auto *iGraph = dynamic_cast<IncidenceListGraph*>(diGraph);
-            iGraph->mapArcs([this,&edges,iGraph] (Arc * arc) {
+            // zero-weight arcs are never colored and thus ignored by
+            // fans and cd-paths, no need to deactivate them
+            diGraph->mapArcs([this,&edges] (Arc * arc) {
                 if (weights->getValue(arc) > 0) {
                     edges.push_back(arc);
-                } else  {
-                    iGraph->deactivateArc(arc);
                 }
             });
 
             std::sort(edges.begin(), edges.end(), [this] (const Arc* lop, const Arc* rop) {
                 return weights->getValue(lop) > weights->getValue(rop);
             });
+            }
 
-            for (auto &a : edges) {
+            DJM_TRACED_PHASE(phase_times, "coloring");
+            steps.clear();
+            for (auto arc_index = 0UL; arc_index < edges.size(); arc_index++) {
+                // cancellation point every 1024 arcs
+                if ((arc_index & 1023) == 0 && stop_requested()) {
+                    break;
+                }
+                auto &a = edges[arc_index];
+                // colored by a warm start
+                if (edge_color(a) != UNCOLORED) {
+                    continue;
+                }
                 if (matched[a->getTail()] < num_matchings
                         && matched[a->getHead()] < num_matchings) {
                     auto c = color_edge(a, a->getTail());
@@ -443,6 +502,8 @@ private:
                     }
                 }
             }
+            // fans, cd-paths and rotations within the coloring
+            steps.add_to(phase_times);
         return colors;
     }
 };
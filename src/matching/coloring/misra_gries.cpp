@@ -10,90 +10,103 @@ void MisraGries::run() {
     using namespace Algora;
     std::vector<bool> locally_free_color(delta, true);
 
-    diGraph->mapVertices([&] (Vertex* v) {
-        // determine free colors of this node
-        auto free_edge_colors_am = [&] (Arc * arc) {
-            assert(arc->isValid());
-            if (edge_color[arc] != UNCOLORED) {
-                locally_free_color[edge_color[arc]] = false;
-                touched_locally_free_color.push_back(edge_color[arc]);
-            }
-        };
-        diGraph->mapOutgoingArcs(v, free_edge_colors_am);
-        diGraph->mapIncomingArcs(v, free_edge_colors_am);
-
-        // should suffice to only map over outgoing arcs here
-        diGraph->mapOutgoingArcs(v, [&] (Arc * arc) {
-            if (edge_color[arc] != UNCOLORED) {
-                return;
-            }
+    {
+        DJM_TRACED_PHASE(phase_times, "coloring");
+        steps.clear();
+        diGraph->mapVertices([&] (Vertex* v) {
+            // determine free colors of this node
+            auto free_edge_colors_am = [&] (Arc * arc) {
+                assert(arc->isValid());
+                if (edge_color[arc] != UNCOLORED) {
+                    locally_free_color[edge_color[arc]] = false;
+                    touched_locally_free_color.push_back(edge_color[arc]);
+                }
+            };
+            diGraph->mapOutgoingArcs(v, free_edge_colors_am);
+            diGraph->mapIncomingArcs(v, free_edge_colors_am);
+
+            // should suffice to only map over outgoing arcs here
+            diGraph->mapOutgoingArcs(v, [&] (Arc * arc) {
+                if (edge_color[arc] != UNCOLORED) {
+                    return;
+                }
 
-            // build fan
-            maximal_fan(arc);
-
-            // determine c-d colors
-            // for d we should still be able to determine the first free using the free_color vector
-            // which is filled during the fan creation
-            auto c_color = getFirstFreeColor(locally_free_color);
-            auto d_color = getFirstFreeColor(free_color);
-
-            // path inversion and shrinking of fan only necessary
-            // if d is not free on v
-            if (!locally_free_color[d_color]){
-                // invert the cd-path
-                invertCdPath(d_color, c_color, v);
-                // and c becomes locally not free
-                locally_free_color[d_color] = true;
-                locally_free_color[c_color] = false;
-                touched_locally_free_color.push_back(c_color);
-
-                // find w \in F such that d free on w, F'[i,w] is a fan
-                shrink_fan(touched_path, c_color);
-
-                for (auto el : touched_path) {
-                    visited_path[el] = false;
+                // build fan
+                DJM_STEP_START(steps);
+                maximal_fan(arc);
+                DJM_STEP_LAP(steps, FAN_STEP);
+                events.sample(event_type::FAN_SIZE, fan.size());
+
+                // determine c-d colors
+                // for d we should still be able to determine the first free using the free_color vector
+                // which is filled during the fan creation
+                auto c_color = getFirstFreeColor(locally_free_color);
+                auto d_color = getFirstFreeColor(free_color);
+
+                // path inversion and shrinking of fan only necessary
+                // if d is not free on v
+                if (!locally_free_color[d_color]){
+                    // invert the cd-path
+                    invertCdPath(d_color, c_color, v);
+                    events.sample(event_type::CD_PATH_LENGTH, touched_path.size() - 1);
+                    // and c becomes locally not free
+                    locally_free_color[d_color] = true;
+                    locally_free_color[c_color] = false;
+                    touched_locally_free_color.push_back(c_color);
+
+                    // find w \in F such that d free on w, F'[i,w] is a fan
+                    shrink_fan(touched_path, c_color);
+
+                    for (auto el : touched_path) {
+                        visited_path[el] = false;
+                    }
+                    touched_path.clear();
+                    DJM_STEP_LAP(steps, CD_PATH_STEP);
                 }
-                touched_path.clear();
-            }
 
-            // rotate fan
-            auto rot_edge_id = fan.back();
-            auto prev = edge_color[rot_edge_id];
-            rotateFan();
+                // rotate fan
+                auto rot_edge_id = fan.back();
+                auto prev = edge_color[rot_edge_id];
+                rotateFan();
+                DJM_STEP_LAP(steps, ROTATE_STEP);
 
-            // set edge_color[e] = d
-            if (prev != UNCOLORED) {
-                assert(prev < delta);
-                free_color[prev] = true;
-            }
-            edge_color[rot_edge_id] = d_color;
-            locally_free_color[d_color] = false;
+                // set edge_color[e] = d
+                if (prev != UNCOLORED) {
+                    assert(prev < delta);
+                    free_color[prev] = true;
+                }
+                edge_color[rot_edge_id] = d_color;
+                locally_free_color[d_color] = false;
 
-            // housekeeping
-            for (auto el : touched_free_color) {
-                free_color[el] = true;
-            }
+                // housekeeping
+                for (auto el : touched_free_color) {
+                    free_color[el] = true;
+                }
 
-            for (auto el : fan) {
-                fan_marked[el->getFirst()] = false;
-                fan_marked[el->getSecond()] = false;
-            }
-            fan_marked[v] = false;
+                for (auto el : fan) {
+                    fan_marked[el->getFirst()] = false;
+                    fan_marked[el->getSecond()] = false;
+                }
+                fan_marked[v] = false;
 
-            fan.clear();
-            touched_free_color.clear();
+                fan.clear();
+                touched_free_color.clear();
 
-            touched_locally_free_color.push_back(d_color);
+                touched_locally_free_color.push_back(d_color);
+            });
+            // housekeeping
+            for (auto el : touched_locally_free_color) {
+                locally_free_color[el] = true;
+            }
+            touched_locally_free_color.clear();
         });
-        // housekeeping
-        for (auto el : touched_locally_free_color) {
-            locally_free_color[el] = true;
-        }
-        touched_locally_free_color.clear();
-    });
+        // fans, cd-paths and rotations within the coloring
+        steps.add_to(phase_times);
+    }
 
     // write mates to the mate data structure
     // easier than keeping track of mates throughout execution
+    DJM_TRACED_PHASE(phase_times, "mates");
     max_color = 0;
     diGraph->mapArcs([&] (Arc * arc) {
         if (edge_color[arc] != UNCOLORED) {
@@ -89,6 +89,10 @@ protected:
 
         Algora::FastPropertyMap<char> visited_path;
 
+        // per colored arc, too fine-grained for phases
+        enum coloring_step { FAN_STEP, CD_PATH_STEP, ROTATE_STEP };
+        StepTimes steps { { "fan", "cd-path", "rotate" } };
+
         void maximal_fan(Algora::Arc * arc);
 
         void shrink_fan(std::vector<Algora::Vertex*> cdpath, unsigned int c);
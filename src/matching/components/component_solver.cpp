@@ -0,0 +1,77 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "matching/components/component_solver.h"
+
+#include "tools/chronotimer.h"
+#include "tools/parallel.h"
+
+bool component_solver::prepare() {
+    if (!matching_algorithm::prepare() || weights == nullptr) {
+        return false;
+    }
+    DJM_TRACE("decompose");
+    ChronoTimer timer;
+    components.compute(diGraph, weights, max_vertex_id, config.threads);
+    decomposition_seconds = timer.elapsed();
+    return true;
+}
+
+void component_solver::run() {
+    using namespace Algora;
+    stats.assign(components.size(), {0, 0, 0, 0.0});
+    std::vector<char> completed(components.size(), false);
+    std::vector<PhaseTimes> component_phases(components.size());
+    std::vector<event_counters> component_events(components.size());
+
+    DJM_TRACED_PHASE(phase_times, "solve components");
+    parallel_for(components.size(), config.threads, [this,&completed,&component_phases,&component_events] (std::size_t i) {
+        // stop_requested() would modify interrupted concurrently
+        if (stop_flag != nullptr && stop_flag->load(std::memory_order_relaxed)) {
+            return;
+        }
+        DJM_TRACE("component");
+        ChronoTimer timer;
+        auto &comp = components[i];
+        std::unique_ptr<matching_algorithm> algo(prototype->clone());
+        algo->set_stop_flag(stop_flag);
+        algo->set_max_vertex_id(comp.graph.getSize());
+        algo->setGraph(&comp.graph);
+        algo->setWeights(&comp.weights);
+        algo->set_num_matchings(num_matchings);
+        if (!algo->prepare()) {
+            return;
+        }
+        algo->run();
+
+        // components are vertex-disjoint, so tasks write disjoint entries
+        comp.graph.mapArcs([this,&algo,&comp] (Arc *arc) {
+            if (algo->isMatched(arc)) {
+                set_edge_color(comp.global_arc[arc], algo->getEdgeColor(arc));
+            }
+        });
+        stats[i] = {comp.graph.getSize(), comp.graph.getNumArcs(false), algo->deliver(), timer.elapsed()};
+        completed[i] = !algo->was_interrupted();
+        component_phases[i] = algo->get_phase_times();
+        component_events[i] = algo->get_event_counters();
+    });
+
+    // phases of all components summed up, i.e., in CPU time if run in parallel
+    for (const auto &phases : component_phases) {
+        phase_times.merge(phases);
+    }
+    for (const auto &e : component_events) {
+        events.merge(e);
+    }
+
+    total_weight = 0;
+    for (auto i = 0UL; i < stats.size(); i++) {
+        total_weight += stats[i].weight;
+        if (!completed[i]) {
+            interrupted = true;
+        }
+    }
+}
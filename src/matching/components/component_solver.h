@@ -0,0 +1,69 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "matching/matching_algorithm.h"
+#include "matching/components/connected_components.h"
+
+// Runs an algorithm independently on each connected component of the
+// graph and merges the results. Components are solved concurrently on
+// config.threads threads, largest first, each by a fresh clone() of the
+// given algorithm on a copy of the component.
+// As b-matchings of different components never share a vertex, the
+// merged solution is valid and its weight is the sum of the weights of
+// the component solutions.
+class component_solver : public matching_algorithm {
+    public:
+        struct component_stats {
+            unsigned long vertices;
+            unsigned long arcs;
+            EdgeWeight weight;
+            double time;
+        };
+
+        // takes ownership of algo, which must support clone()
+        component_solver(MatchingConfig &config, matching_algorithm *algo)
+            : matching_algorithm(config), prototype(algo) {}
+        virtual ~component_solver() = default;
+
+        // decomposes the graph into its components
+        bool prepare() override;
+        void run() override;
+
+        matching_algorithm *clone() const override {
+            return new component_solver(config, prototype->clone());
+        }
+
+        double getThreshold() const noexcept override {
+            return prototype->getThreshold();
+        }
+
+        std::string getName() const noexcept override {
+            return prototype->getName() + " [cc]";
+        }
+
+        std::string getShortName() const noexcept override {
+            return prototype->getShortName() + "+cc";
+        }
+
+        // in the order the components were solved, i.e., by decreasing size
+        const std::vector<component_stats> &get_component_stats() const noexcept {
+            return stats;
+        }
+
+        double decomposition_time() const noexcept {
+            return decomposition_seconds;
+        }
+
+    private:
+        std::unique_ptr<matching_algorithm> prototype;
+        connected_components components;
+        std::vector<component_stats> stats;
+        double decomposition_seconds{0.0};
+};
@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "matching/components/connected_components.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+#include "tools/parallel.h"
+
+namespace {
+
+// union-find on vertex ids that can be used from several threads:
+// roots are linked by compare-and-swap, always the larger id below the
+// smaller one, and paths are halved while searching
+class concurrent_union_find {
+    public:
+        concurrent_union_find(std::size_t size)
+            : parent(size) {
+            for (std::size_t i = 0; i < size; i++) {
+                parent[i].store(i, std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t find(std::size_t x) {
+            auto p = parent[x].load(std::memory_order_relaxed);
+            while (p != x) {
+                auto gp = parent[p].load(std::memory_order_relaxed);
+                if (gp != p) {
+                    parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+                }
+                x = gp;
+                p = parent[x].load(std::memory_order_relaxed);
+            }
+            return x;
+        }
+
+        void unite(std::size_t x, std::size_t y) {
+            while (true) {
+                x = find(x);
+                y = find(y);
+                if (x == y) {
+                    return;
+                }
+                if (x < y) {
+                    std::swap(x, y);
+                }
+                auto expected = x;
+                if (parent[x].compare_exchange_strong(expected, y, std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+        }
+
+    private:
+        std::vector<std::atomic<std::size_t>> parent;
+};
+
+}
+
+void connected_components::compute(Algora::DiGraph *graph, Algora::FastPropertyMap<EdgeWeight> *weights,
+        Algora::DiGraph::size_type max_vertex_id, unsigned threads) {
+    using namespace Algora;
+    components.clear();
+
+    std::vector<Arc*> arcs;
+    arcs.reserve(graph->getNumArcs(false));
+    graph->mapArcs([weights,&arcs] (Arc *arc) {
+        if (weights->getValue(arc) > 0 && !arc->isLoop()) {
+            arcs.push_back(arc);
+        }
+    });
+
+    concurrent_union_find uf(max_vertex_id);
+    const auto chunk = 1UL << 14;
+    const auto num_chunks = (arcs.size() + chunk - 1) / chunk;
+    parallel_for(num_chunks, threads, [&arcs,&uf,chunk] (std::size_t c) {
+        const auto end = std::min(arcs.size(), (c + 1) * chunk);
+        for (auto i = c * chunk; i < end; i++) {
+            uf.unite(arcs[i]->getTail()->getId(), arcs[i]->getHead()->getId());
+        }
+    });
+
+    // number the roots of all vertices that have a positive arc
+    const auto NONE = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> index_of_root(max_vertex_id, NONE);
+    std::vector<std::size_t> num_arcs;
+    std::vector<std::vector<Arc*>> arcs_of;
+    for (auto *arc : arcs) {
+        auto root = uf.find(arc->getTail()->getId());
+        if (index_of_root[root] == NONE) {
+            index_of_root[root] = num_arcs.size();
+            num_arcs.push_back(0);
+        }
+        num_arcs[index_of_root[root]]++;
+    }
+    arcs_of.resize(num_arcs.size());
+    for (auto i = 0UL; i < num_arcs.size(); i++) {
+        arcs_of[i].reserve(num_arcs[i]);
+    }
+    for (auto *arc : arcs) {
+        arcs_of[index_of_root[uf.find(arc->getTail()->getId())]].push_back(arc);
+    }
+
+    // largest components first, so that they start early
+    std::vector<std::size_t> order(arcs_of.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&num_arcs] (std::size_t lop, std::size_t rop) {
+        return num_arcs[lop] > num_arcs[rop];
+    });
+
+    components.resize(order.size());
+    // local vertex per global vertex id, each entry is written by one task only
+    std::vector<Vertex*> local_vertex(max_vertex_id, nullptr);
+    parallel_for(order.size(), threads, [&] (std::size_t i) {
+        auto comp = std::make_unique<component>();
+        auto local_of = [&comp,&local_vertex] (Vertex *v) {
+            auto &local = local_vertex[v->getId()];
+            if (local == nullptr) {
+                local = comp->graph.addVertex();
+                comp->global_vertex[local] = v;
+            }
+            return local;
+        };
+        for (auto *arc : arcs_of[order[i]]) {
+            auto local = comp->graph.addArc(local_of(arc->getTail()), local_of(arc->getHead()));
+            comp->weights[local] = weights->getValue(arc);
+            comp->global_arc[local] = arc;
+        }
+        components[i] = std::move(comp);
+    });
+}
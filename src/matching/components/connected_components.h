@@ -0,0 +1,46 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "graph/digraph.h"
+#include "graph.incidencelist/incidencelistgraph.h"
+#include "property/fastpropertymap.h"
+#include "matching/matching_defs.h"
+
+// Splits a weighted graph into its connected components with respect to
+// arcs of positive weight and copies each component with at least one
+// such arc into a graph of its own.
+// Components are found by a concurrent union-find over all arcs, and the
+// component graphs are built in parallel, too.
+class connected_components {
+    public:
+        struct component {
+            Algora::IncidenceListGraph graph;
+            Algora::FastPropertyMap<EdgeWeight> weights{0};
+            // arc / vertex of the input graph per arc / vertex of graph
+            Algora::FastPropertyMap<Algora::Arc*> global_arc{nullptr};
+            Algora::FastPropertyMap<Algora::Vertex*> global_vertex{nullptr};
+        };
+
+        // vertex ids of graph must be smaller than max_vertex_id
+        void compute(Algora::DiGraph *graph, Algora::FastPropertyMap<EdgeWeight> *weights,
+                Algora::DiGraph::size_type max_vertex_id, unsigned threads);
+
+        // components in descending order of their number of arcs
+        std::size_t size() const noexcept {
+            return components.size();
+        }
+
+        component &operator[](std::size_t i) {
+            return *components[i];
+        }
+
+    private:
+        std::vector<std::unique_ptr<component>> components;
+};
@@ -0,0 +1,140 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "matching/dynamic/demand_window.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <sstream>
+#include <unordered_map>
+
+demand_window::demand_window(unsigned long long length, unsigned long long slide)
+    : length(length), slide(slide), weights(0), touched(false) {
+    assert(length > 0);
+    assert(slide > 0);
+}
+
+bool demand_window::read(std::istream &in, std::string &error) {
+    using namespace Algora;
+    std::unordered_map<unsigned long long, Vertex*> vertex_of_label;
+    std::unordered_map<std::uint64_t, Arc*> arc_of_pair;
+
+    auto get_vertex = [this,&vertex_of_label] (unsigned long long label) {
+        auto &v = vertex_of_label[label];
+        if (v == nullptr) {
+            v = graph.addVertex();
+            assert(v->getId() == labels.size());
+            labels.push_back(label);
+        }
+        return v;
+    };
+
+    std::string line;
+    unsigned long line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        if (line.empty() || line[0] == '%') {
+            continue;
+        }
+        std::istringstream fields(line);
+        unsigned long long u, v;
+        EdgeWeight w = 1;
+        unsigned long long t = 0;
+        if (!(fields >> u >> v)) {
+            error = "expected two vertex ids in line " + std::to_string(line_no);
+            return false;
+        }
+        // weight and timestamp are optional
+        if (fields >> w) {
+            fields >> t;
+        }
+        if (u == v || w == 0) {
+            continue;
+        }
+
+        auto tail = get_vertex(u);
+        auto head = get_vertex(v);
+        const auto key = (static_cast<std::uint64_t>(tail->getId()) << 32) | head->getId();
+        auto &arc = arc_of_pair[key];
+        if (arc == nullptr) {
+            arc = graph.addArc(tail, head);
+        }
+        records.push_back({arc, w, t});
+    }
+
+    std::stable_sort(records.begin(), records.end(), [] (const record &lop, const record &rop) {
+        return lop.timestamp < rop.timestamp;
+    });
+    reset();
+    return true;
+}
+
+void demand_window::reset() {
+    weights.resetAll(graph.getNumArcs(true));
+    touched.resetAll(graph.getNumArcs(true));
+    first_active = 0;
+    next_record = 0;
+    begin = 0;
+    windows = 0;
+    active_arcs = 0;
+}
+
+void demand_window::touch(Algora::Arc *arc, std::vector<Algora::Arc*> &changed) {
+    if (!touched[arc]) {
+        touched[arc] = true;
+        changed.push_back(arc);
+    }
+}
+
+bool demand_window::next_window(std::vector<Algora::Arc*> &changed) {
+    changed.clear();
+    if (records.empty()) {
+        return false;
+    }
+    if (windows == 0) {
+        begin = records.front().timestamp;
+    } else if (window_end() > records.back().timestamp) {
+        // the current window already covers the end of the trace
+        return false;
+    } else {
+        begin += slide;
+    }
+    windows++;
+
+    // expire records that fell out of the window
+    while (first_active < next_record && records[first_active].timestamp < begin) {
+        const auto &r = records[first_active++];
+        auto &w = weights[r.arc];
+        w -= r.weight;
+        if (w == 0) {
+            active_arcs--;
+        }
+        touch(r.arc, changed);
+    }
+    // skip records between windows if slide > length
+    if (first_active == next_record) {
+        while (next_record < records.size() && records[next_record].timestamp < begin) {
+            next_record++;
+        }
+        first_active = next_record;
+    }
+    // add records that entered the window
+    while (next_record < records.size() && records[next_record].timestamp < window_end()) {
+        const auto &r = records[next_record++];
+        auto &w = weights[r.arc];
+        if (w == 0) {
+            active_arcs++;
+        }
+        w += r.weight;
+        touch(r.arc, changed);
+    }
+
+    for (auto *arc : changed) {
+        touched[arc] = false;
+    }
+    return true;
+}
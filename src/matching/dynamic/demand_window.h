@@ -0,0 +1,108 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "graph.incidencelist/incidencelistgraph.h"
+#include "property/fastpropertymap.h"
+#include "matching/matching_defs.h"
+
+// Aggregated demand graph over a sliding or tumbling time window.
+// Reads timestamped demand records "u v w t" (KONECT format, the fourth
+// column being the timestamp) and sums up the demand of all records
+// with a timestamp in [begin, begin + length) per arc.
+// Windows start at the first timestamp and advance by slide, so
+// slide == length gives tumbling windows.
+// All arcs that occur anywhere in the trace are created up front and
+// stay in the graph, arcs without demand in the current window just
+// have weight 0. Thus, the graph and the vertex and arc ids are the same
+// for all windows, and moving to the next window only changes weights.
+class demand_window {
+    public:
+        struct record {
+            Algora::Arc *arc;
+            EdgeWeight weight;
+            unsigned long long timestamp;
+        };
+
+        demand_window(unsigned long long length, unsigned long long slide);
+
+        // reads all records from in, returns false and sets error on
+        // malformed input
+        bool read(std::istream &in, std::string &error);
+
+        Algora::IncidenceListGraph *getDiGraph() {
+            return &graph;
+        }
+
+        Algora::FastPropertyMap<EdgeWeight> *getArcWeights() {
+            return &weights;
+        }
+
+        Algora::DiGraph::size_type getMaxVertexId() const {
+            return labels.size();
+        }
+
+        // label of v in the input
+        unsigned long long vertex_label(const Algora::Vertex *v) const {
+            return labels[v->getId()];
+        }
+
+        unsigned long long vertex_label(unsigned long long id) const {
+            return labels[id];
+        }
+
+        // moves to the next window, returns false if there is none;
+        // changed receives all arcs whose weight may have changed
+        bool next_window(std::vector<Algora::Arc*> &changed);
+
+        // rewinds to before the first window, all weights become 0
+        void reset();
+
+        unsigned long long window_begin() const noexcept {
+            return begin;
+        }
+
+        unsigned long long window_end() const noexcept {
+            return begin + length;
+        }
+
+        unsigned long num_windows() const noexcept {
+            return windows;
+        }
+
+        unsigned long num_records() const noexcept {
+            return records.size();
+        }
+
+        // number of arcs with positive weight in the current window
+        unsigned long num_active_arcs() const noexcept {
+            return active_arcs;
+        }
+
+    private:
+        unsigned long long length;
+        unsigned long long slide;
+
+        Algora::IncidenceListGraph graph;
+        Algora::FastPropertyMap<EdgeWeight> weights;
+        std::vector<unsigned long long> labels;
+        // sorted by timestamp
+        std::vector<record> records;
+
+        // records [first_active, next_record) are in the current window
+        std::vector<record>::size_type first_active{0};
+        std::vector<record>::size_type next_record{0};
+        unsigned long long begin{0};
+        unsigned long windows{0};
+        unsigned long active_arcs{0};
+        Algora::FastPropertyMap<bool> touched;
+
+        void touch(Algora::Arc *arc, std::vector<Algora::Arc*> &changed);
+};
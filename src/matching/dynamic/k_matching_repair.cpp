@@ -0,0 +1,370 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "matching/dynamic/k_matching_repair.h"
+
+#include <algorithm>
+
+k_matching_repair::~k_matching_repair() {
+    stop_observing_graph();
+}
+
+void k_matching_repair::adopt(matching_algorithm &solved) {
+    using namespace Algora;
+    assert(num_matchings > 0);
+    total_weight = solved.deliver();
+    solved.swapData(edge_color, mate);
+    assert(mate.size() == num_matchings);
+
+    known_weight.setDefaultValue(0);
+    known_weight.resetAll(diGraph->getNumArcs(false));
+    diGraph->mapArcs([this] (Arc *arc) {
+        known_weight[arc] = weights->getValue(arc);
+    });
+    is_dirty.setDefaultValue(false);
+    is_dirty.resetAll(max_vertex_id);
+    dirty.clear();
+
+    journal_index.setDefaultValue(NO_ENTRY);
+    journal_index.resetAll(diGraph->getNumArcs(false));
+    journal.clear();
+    changes.clear();
+}
+
+void k_matching_repair::observe_graph() {
+    using namespace Algora;
+    if (observing) {
+        return;
+    }
+    diGraph->onArcAdd(this, [this] (Arc *arc) {
+        arc_added(arc);
+    });
+    diGraph->onArcRemove(this, [this] (Arc *arc) {
+        arc_removed(arc);
+    });
+    // vertices are removed only once isolated, forget them
+    diGraph->onVertexRemove(this, [this] (Vertex *v) {
+        is_dirty[v] = false;
+    });
+    observing = true;
+}
+
+void k_matching_repair::stop_observing_graph() {
+    if (!observing) {
+        return;
+    }
+    diGraph->removeOnArcAdd(this);
+    diGraph->removeOnArcRemove(this);
+    diGraph->removeOnVertexRemove(this);
+    observing = false;
+}
+
+void k_matching_repair::onDiGraphUnset() {
+    stop_observing_graph();
+    matching_algorithm::onDiGraphUnset();
+}
+
+void k_matching_repair::arc_added(Algora::Arc *arc) {
+    edge_color[arc] = UNCOLORED;
+    journal_index[arc] = NO_ENTRY;
+    // weight is set after the arc has been added, so this is seen
+    // as a change from 0 by detect_weight_changes()
+    known_weight[arc] = 0;
+    mark_dirty(arc->getTail());
+    mark_dirty(arc->getHead());
+}
+
+void k_matching_repair::arc_removed(Algora::Arc *arc) {
+    record(arc);
+    journal[journal_index[arc]].removed = true;
+    uncolor(arc);
+    // the id may be reused by a new arc
+    journal_index[arc] = NO_ENTRY;
+    known_weight[arc] = 0;
+    mark_dirty(arc->getTail());
+    mark_dirty(arc->getHead());
+}
+
+void k_matching_repair::weight_changed(Algora::Arc *arc, const EdgeWeight &old_weight) {
+    const auto new_weight = weights->getValue(arc);
+    known_weight[arc] = new_weight;
+    if (edge_color[arc] != UNCOLORED) {
+        total_weight = total_weight - old_weight + new_weight;
+        // with switching costs, keeping a link without demand is free
+        if (new_weight == 0 && switch_penalty == 0) {
+            uncolor(arc);
+        }
+    }
+    mark_dirty(arc->getTail());
+    mark_dirty(arc->getHead());
+}
+
+unsigned long k_matching_repair::detect_weight_changes() {
+    using namespace Algora;
+    auto changes = 0UL;
+    diGraph->mapArcs([this,&changes] (Arc *arc) {
+        const auto old_weight = known_weight(arc);
+        if (weights->getValue(arc) != old_weight) {
+            weight_changed(arc, old_weight);
+            changes++;
+        }
+    });
+    return changes;
+}
+
+void k_matching_repair::mark_dirty(Algora::Vertex *v) {
+    if (!is_dirty[v]) {
+        is_dirty[v] = true;
+        dirty.push_back(v);
+    }
+}
+
+Algora::Arc *k_matching_repair::matched_arc(Algora::Vertex *v, const color_t &c) {
+    auto m = mate[c][v];
+    if (m == nullptr) {
+        return nullptr;
+    }
+    // with antiparallel arcs, the colored one may point either way
+    auto arc = diGraph->findArc(v, m);
+    if (arc == nullptr || edge_color[arc] != c) {
+        arc = diGraph->findArc(m, v);
+    }
+    assert(arc != nullptr && edge_color[arc] == c);
+    return arc;
+}
+
+void k_matching_repair::record(Algora::Arc *arc, const color_t &old_color) {
+    if (journal_index[arc] == NO_ENTRY) {
+        journal_index[arc] = journal.size();
+        journal.push_back({ arc, old_color, arc->getTail()->getId(), arc->getHead()->getId(), false });
+    }
+}
+
+long long k_matching_repair::switch_cost(const Algora::Arc *arc, const color_t &from, const color_t &to) const {
+    if (switch_penalty == 0 || from == to) {
+        return 0;
+    }
+    const auto index = journal_index(arc);
+    const auto before = index == NO_ENTRY ? edge_color(arc) : journal[index].old_color;
+    auto num_changes = [this,&before] (const color_t &c) {
+        return (before != UNCOLORED && c != before ? 1LL : 0LL)
+            + (c != UNCOLORED && c != before ? 1LL : 0LL);
+    };
+    return static_cast<long long>(switch_penalty) * (num_changes(to) - num_changes(from));
+}
+
+void k_matching_repair::uncolor(Algora::Arc *arc) {
+    const auto c = edge_color[arc];
+    if (c == UNCOLORED) {
+        return;
+    }
+    record(arc);
+    total_weight -= known_weight[arc];
+    edge_color[arc] = UNCOLORED;
+    const auto s = arc->getFirst();
+    const auto t = arc->getSecond();
+    if (mate[c][s] == t) {
+        mate[c][s] = nullptr;
+    }
+    if (mate[c][t] == s) {
+        mate[c][t] = nullptr;
+    }
+}
+
+bool k_matching_repair::insert_arc(Algora::Arc *arc) {
+    using namespace Algora;
+    const auto s = arc->getFirst();
+    const auto t = arc->getSecond();
+    const auto w = weights->getValue(arc);
+    const auto gain = static_cast<long long>(w);
+
+    // free color with maximum gain, the first one without switching costs
+    color_t best_color = UNCOLORED;
+    long long best_gain = 0;
+    for (color_t c = 0; c < num_matchings; c++) {
+        if (mate[c][s] == nullptr && mate[c][t] == nullptr) {
+            const auto color_gain = gain - switch_cost(arc, UNCOLORED, c);
+            if (color_gain > best_gain) {
+                best_gain = color_gain;
+                best_color = c;
+            }
+            if (switch_penalty == 0) {
+                break;
+            }
+        }
+    }
+    if (best_color != UNCOLORED) {
+        record(arc);
+        edge_color[arc] = best_color;
+        mate[best_color][s] = t;
+        mate[best_color][t] = s;
+        total_weight += w;
+        return true;
+    }
+
+    // augment: replace the conflicting arcs in the color with maximum gain
+    long long best_loss = gain;
+    for (color_t c = 0; c < num_matchings; c++) {
+        long long loss = switch_cost(arc, UNCOLORED, c);
+        for (auto *v : { s, t }) {
+            auto conflict = matched_arc(v, c);
+            if (conflict) {
+                loss += weights->getValue(conflict) + switch_cost(conflict, c, UNCOLORED);
+            }
+        }
+        if (loss < best_loss) {
+            best_loss = loss;
+            best_color = c;
+        }
+    }
+    if (best_color == UNCOLORED) {
+        return false;
+    }
+
+    for (auto *v : { s, t }) {
+        auto conflict = matched_arc(v, best_color);
+        if (conflict) {
+            // the other endpoint lost a partner and might take another one
+            mark_dirty(conflict->getOther(v));
+            uncolor(conflict);
+        }
+    }
+    record(arc);
+    edge_color[arc] = best_color;
+    mate[best_color][s] = t;
+    mate[best_color][t] = s;
+    total_weight += w;
+    return true;
+}
+
+void k_matching_repair::run() {
+    using namespace Algora;
+    std::vector<Arc*> candidates;
+    // dirty may grow while repairing, but only by strictly improving
+    // steps, so this terminates
+    for (auto i = 0UL; i < dirty.size(); i++) {
+        auto v = dirty[i];
+        if (!is_dirty[v]) {
+            // removed in the meantime
+            continue;
+        }
+        is_dirty[v] = false;
+
+        // try to replace matched arcs by two heavier ones
+        for (auto c = 0U; c < num_matchings; c++) {
+            auto arc = matched_arc(v, c);
+            if (arc && stable_swap(arc, c)) {
+                // the former partner is now matched otherwise
+                mark_dirty(arc->getOther(v));
+            }
+        }
+
+        // try to add uncolored arcs, heaviest first
+        candidates.clear();
+        diGraph->mapIncidentArcs(v, [this,&candidates] (Arc *arc) {
+            if (edge_color[arc] == UNCOLORED && weights->getValue(arc) > 0 && !arc->isLoop()) {
+                candidates.push_back(arc);
+            }
+        });
+        std::sort(candidates.begin(), candidates.end(), [this] (const Arc *lop, const Arc *rop) {
+            return weights->getValue(lop) > weights->getValue(rop);
+        });
+        for (auto *arc : candidates) {
+            // augmenting may have colored arc already
+            if (edge_color[arc] == UNCOLORED) {
+                insert_arc(arc);
+            }
+        }
+    }
+    dirty.clear();
+
+    // per-matching diff against the solution before the changes
+    changes.clear();
+    for (const auto &entry : journal) {
+        const auto now = entry.removed ? UNCOLORED : edge_color(entry.arc);
+        if (!entry.removed) {
+            journal_index[entry.arc] = NO_ENTRY;
+        }
+        if (now == entry.old_color) {
+            continue;
+        }
+        if (entry.old_color != UNCOLORED) {
+            changes.push_back({ entry.tail, entry.head, entry.old_color, false });
+        }
+        if (now != UNCOLORED) {
+            changes.push_back({ entry.tail, entry.head, now, true });
+        }
+    }
+    journal.clear();
+    std::stable_sort(changes.begin(), changes.end(), [] (const link_change &lop, const link_change &rop) {
+        return lop.color < rop.color || (lop.color == rop.color && !lop.added && rop.added);
+    });
+
+    if (config.sanitycheck) {
+        sanityCheck();
+    }
+}
+
+bool k_matching_repair::stable_swap(Algora::Arc *arc, const color_t &c) {
+    using namespace Algora;
+    const auto s = arc->getFirst();
+    const auto t = arc->getSecond();
+    if (switch_penalty == 0) {
+        if (!swap_subroutine(arc, c)) {
+            return false;
+        }
+        // the arcs colored instead were uncolored before
+        record(arc, c);
+        record(matched_arc(s, c), UNCOLORED);
+        record(matched_arc(t, c), UNCOLORED);
+        return true;
+    }
+
+    // best replacement at v in color c whose other endpoint is neither
+    // excluded nor matched in c, valued by weight minus switching cost
+    auto best_at = [this,&c] (Vertex *v, const Vertex *excluded, const Vertex *excluded2, long long &value) {
+        Arc *best = nullptr;
+        value = 0;
+        diGraph->mapIncidentArcs(v, [&] (Arc *candidate) {
+            const auto other = candidate->getOther(v);
+            if (edge_color[candidate] != UNCOLORED || candidate->isLoop() || mate[c][other] != nullptr
+                    || other == excluded || other == excluded2) {
+                return;
+            }
+            const auto candidate_value = static_cast<long long>(weights->getValue(candidate))
+                - switch_cost(candidate, UNCOLORED, c);
+            if (candidate_value > value) {
+                value = candidate_value;
+                best = candidate;
+            }
+        });
+        return best;
+    };
+
+    long long lop_value, rop_value;
+    auto lop = best_at(s, t, nullptr, lop_value);
+    if (lop == nullptr) {
+        return false;
+    }
+    auto rop = best_at(t, s, lop->getOther(s), rop_value);
+    if (rop == nullptr) {
+        return false;
+    }
+    const auto loss = static_cast<long long>(weights->getValue(arc)) + switch_cost(arc, c, UNCOLORED);
+    if (lop_value + rop_value <= loss) {
+        return false;
+    }
+
+    uncolor(arc);
+    for (auto *a : { lop, rop }) {
+        record(a);
+        edge_color[a] = c;
+        mate[c][a->getFirst()] = a->getSecond();
+        mate[c][a->getSecond()] = a->getFirst();
+        total_weight += weights->getValue(a);
+    }
+    return true;
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <limits>
+#include <vector>
+
+#include "matching/matching_algorithm.h"
+
+// Maintains k disjoint matchings computed by another algorithm under
+// arc insertions, arc deletions, and weight changes.
+// Changes only mark their endpoints as dirty; run() then repairs the
+// matchings locally around dirty vertices: matched arcs are offered to
+// the swap subroutine, and uncolored incident arcs are inserted either
+// into a common free color or by replacing lighter conflicting arcs.
+// The work per repair is thus proportional to the number of changes
+// times the degree of the affected vertices times k.
+// With a switch penalty, every link that is added to or removed from a
+// matching compared to the solution before the last changes costs the
+// penalty, and repairs only change the solution if weight minus switching
+// cost increases. A recolored link counts as one removal and one addition.
+class k_matching_repair : public matching_algorithm {
+    public:
+        // a link added to or removed from a matching by the last repair
+        struct link_change {
+            unsigned long long tail;
+            unsigned long long head;
+            color_t color;
+            bool added;
+        };
+
+        k_matching_repair(MatchingConfig &config)
+            : matching_algorithm(config) {}
+        virtual ~k_matching_repair();
+
+        // takes over the solution of solved, which must have been run on
+        // the same graph and weights with the same number of matchings
+        void adopt(matching_algorithm &solved);
+
+        // registers for arc additions and removals on the graph
+        void observe_graph();
+        void stop_observing_graph();
+
+        // change notifications
+        void arc_added(Algora::Arc *arc);
+        // to be called before arc is removed from the graph
+        void arc_removed(Algora::Arc *arc);
+        void weight_changed(Algora::Arc *arc, const EdgeWeight &old_weight);
+        // same, with the weight seen last for arc as old weight
+        void weight_changed(Algora::Arc *arc) {
+            weight_changed(arc, known_weight(arc));
+        }
+
+        // Algora does not report weight changes, so compare all arcs
+        // against the weights seen last; returns the number of changed arcs.
+        // This takes time linear in the number of arcs, not in the number
+        // of changes, and is part of the latency of each repair.
+        unsigned long detect_weight_changes();
+
+        // repairs the matchings around all dirty vertices
+        virtual void run() override;
+
+        void set_switch_penalty(const EdgeWeight &penalty) {
+            switch_penalty = penalty;
+        }
+
+        // links changed by the last run() compared to the solution
+        // before the changes preceding it, ordered by matching
+        const std::vector<link_change> &get_changes() const noexcept {
+            return changes;
+        }
+
+        unsigned long num_switches() const noexcept {
+            return changes.size();
+        }
+
+        virtual std::string getName() const noexcept override {
+            return "k-matching repair";
+        }
+
+        virtual std::string getShortName() const noexcept override {
+            return "repair";
+        }
+
+        unsigned long num_dirty_vertices() const noexcept {
+            return dirty.size();
+        }
+
+    protected:
+        virtual void onDiGraphUnset() override;
+
+        // matched arc incident to v in color c, if any
+        Algora::Arc *matched_arc(Algora::Vertex *v, const color_t &c);
+
+        void mark_dirty(Algora::Vertex *v);
+
+        void uncolor(Algora::Arc *arc);
+
+        // tries to color arc, returns whether the objective increased
+        bool insert_arc(Algora::Arc *arc);
+
+        // swap with switching costs, see swap_subroutine
+        bool stable_swap(Algora::Arc *arc, const color_t &c);
+
+        // change in switching cost if arc goes from color from to color to
+        long long switch_cost(const Algora::Arc *arc, const color_t &from, const color_t &to) const;
+
+        // remembers the color arc had before the current changes
+        void record(Algora::Arc *arc, const color_t &old_color);
+        void record(Algora::Arc *arc) {
+            record(arc, edge_color[arc]);
+        }
+
+    private:
+        struct journal_entry {
+            Algora::Arc *arc;
+            color_t old_color;
+            unsigned long long tail;
+            unsigned long long head;
+            bool removed;
+        };
+        static constexpr unsigned long NO_ENTRY = std::numeric_limits<unsigned long>::max();
+
+        EdgeWeight switch_penalty{0};
+        std::vector<journal_entry> journal;
+        Algora::FastPropertyMap<unsigned long> journal_index;
+        std::vector<link_change> changes;
+
+        bool observing{false};
+        Algora::FastPropertyMap<EdgeWeight> known_weight;
+        Algora::FastPropertyMap<bool> is_dirty;
+        std::vector<Algora::Vertex*> dirty;
+};
@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+
+// data-dependent events of an algorithm run; events like swaps are
+// counted, for those with a size like fans, the number of samples,
+// their sum and maximum are kept
+enum class event_type {
+    SWAPS_ATTEMPTED,
+    SWAPS_SUCCESSFUL,
+    FAN_SIZE,
+    CD_PATH_LENGTH,
+    GPA_PATH_LENGTH,
+    GPA_CYCLE_LENGTH,
+    ROMA_ITERATIONS,
+    ROMA_QUEUE_SIZE,
+    NUM_EVENTS
+};
+
+class event_counters {
+    public:
+        struct stat {
+            unsigned long long count{0};
+            unsigned long long sum{0};
+            unsigned long long max{0};
+        };
+
+        static constexpr std::size_t NUM_EVENTS = static_cast<std::size_t>(event_type::NUM_EVENTS);
+
+        static const char *name(event_type e) {
+            static const char *names[NUM_EVENTS] = {
+                "swaps attempted", "swaps successful", "fan size", "cd-path length",
+                "path length", "cycle length", "ROMA iterations", "ROMA queue size"
+            };
+            return names[static_cast<std::size_t>(e)];
+        }
+
+        // events with a size, whose samples are summed up
+        static bool has_size(event_type e) {
+            return e == event_type::FAN_SIZE || e == event_type::CD_PATH_LENGTH
+                || e == event_type::GPA_PATH_LENGTH || e == event_type::GPA_CYCLE_LENGTH
+                || e == event_type::ROMA_QUEUE_SIZE;
+        }
+
+        void count(event_type e, unsigned long long n = 1) {
+            stats[static_cast<std::size_t>(e)].count += n;
+        }
+
+        void sample(event_type e, unsigned long long size) {
+            auto &s = stats[static_cast<std::size_t>(e)];
+            s.count++;
+            s.sum += size;
+            if (size > s.max) {
+                s.max = size;
+            }
+        }
+
+        const stat &operator[](event_type e) const {
+            return stats[static_cast<std::size_t>(e)];
+        }
+
+        bool empty() const {
+            for (const auto &s : stats) {
+                if (s.count > 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void clear() {
+            stats.fill(stat());
+        }
+
+        // adds the events of other, e.g., of a subroutine
+        void merge(const event_counters &other) {
+            for (auto i = 0UL; i < NUM_EVENTS; i++) {
+                stats[i].count += other.stats[i].count;
+                stats[i].sum += other.stats[i].sum;
+                if (other.stats[i].max > stats[i].max) {
+                    stats[i].max = other.stats[i].max;
+                }
+            }
+        }
+
+    private:
+        std::array<stat, NUM_EVENTS> stats;
+};
@@ -13,13 +13,6 @@
 void gpa::run() {
     using namespace Algora;
     std::vector<Arc *> edges;
-    edges.reserve(diGraph->getNumArcs(false));
-
-    diGraph->mapArcs([this, &edges] (Arc * arc) {
-        if (weights->getValue(arc) > 0) {
-            edges.push_back(arc);
-        }
-    });
 
     // for roma: set of all vertices
     if (num_roma > 0) {
@@ -28,37 +21,78 @@ void gpa::run() {
         });
     }
 
-    rng.seed(config.seed);
+    rng.seed(seed);
 
-    // shuffle vector for random tie breaking
-    std::shuffle(edges.begin(), edges.end(), rng);
-    // then sort by weight descending
-    std::sort(edges.begin(), edges.end(), [this] (const Arc * lop, const Arc * rop) {
-        return (*weights)[lop] > (*weights)[rop];
-    });
+    // the sort takes O(m log m), so the deadline is checked around it
+    if (stop_requested()) {
+        return;
+    }
+    {
+    DJM_TRACED_PHASE(phase_times, "sort");
+    if (shared_buckets) {
+        // sorted already, random tie breaking only
+        shared_buckets->shuffled_order(rng, edges);
+    } else {
+        edges.reserve(diGraph->getNumArcs(false));
+        diGraph->mapArcs([this, &edges] (Arc * arc) {
+            if (weights->getValue(arc) > 0) {
+                edges.push_back(arc);
+            }
+        });
+
+        // shuffle vector for random tie breaking
+        std::shuffle(edges.begin(), edges.end(), rng);
+        // then sort by weight descending
+        std::sort(edges.begin(), edges.end(), [this] (const Arc * lop, const Arc * rop) {
+            return (*weights)[lop] > (*weights)[rop];
+        });
+    }
+    }
+    if (stop_requested()) {
+        return;
+    }
 
     std::vector<Arc *> edges_remaining;
-    for (auto bi = 0u; bi < config.b; bi++) {
+    for (auto bi = 0u; bi < num_matchings; bi++) {
+        if (stop_requested()) {
+            return;
+        }
+        DJM_TRACED_PHASE(phase_times, "round");
         path_set pathset(diGraph, max_vertex_id);
+        {
+        DJM_PHASE(phase_times, "grow paths");
         for (auto arc : edges) {
-            if (edge_color[arc] < config.b) {
+            if (edge_color[arc] < num_matchings) {
+                continue;
+            }
+            // endpoint matched in this round by a warm start
+            if (mate[bi][arc->getFirst()] != nullptr || mate[bi][arc->getSecond()] != nullptr) {
+                edges_remaining.push_back(arc);
                 continue;
             }
             pathset.add_if_applicable(arc);
             edges_remaining.push_back(arc);
         }
+        }
+        {
+        DJM_PHASE(phase_times, "extract paths");
         extract_paths_apply_matching(pathset, bi);
+        }
         if (num_roma > 0) {
+            DJM_PHASE(phase_times, "roma");
             roma(bi);
         } else if (swaps && !do_global_swaps) {
+            DJM_PHASE(phase_times, "local swaps");
             local_swaps(bi);
         }
         matched_in_round.clear();
         std::swap(edges, edges_remaining);
         edges_remaining.clear();
+        matching_completed(bi);
     }
 
     if (config.sanitycheck) {
+        DJM_TRACED_PHASE(phase_times, "sanity check");
         sanityCheck();
     }
 }
@@ -85,7 +119,9 @@ bool gpa::roma(const unsigned int round) {
     std::vector<Vertex*> current_vertices(all_vertices);
     std::vector<Vertex*> changed;
     int l = 0;
-    while (!current_vertices.empty() && l++ < num_roma) {
+    while (!current_vertices.empty() && l++ < num_roma && !stop_requested()) {
+        events.count(event_type::ROMA_ITERATIONS);
+        events.sample(event_type::ROMA_QUEUE_SIZE, current_vertices.size());
         for (const auto v : current_vertices) {
             if (mate[round][v] != nullptr) {
                 auto arc = diGraph->findArc(v, mate[round][v]);
@@ -123,6 +159,7 @@ void gpa::extract_paths_apply_matching(path_set & pathset, unsigned round) {
             std::vector<Arc*> first_matching, second_matching;
             std::deque<Arc*> unpacked_cycle;
             unpack_path(p, pathset, unpacked_cycle);
+            events.sample(event_type::GPA_CYCLE_LENGTH, unpacked_cycle.size());
 
             // first split cycle by removing first edge
             auto first = unpacked_cycle.front();
@@ -144,6 +181,7 @@ void gpa::extract_paths_apply_matching(path_set & pathset, unsigned round) {
             }
         } else {
             // a path, not a cycle
+            events.sample(event_type::GPA_PATH_LENGTH, p.get_length());
             if (p.get_length() == 1) {
                 // match single edge directly
                 Arc * arc;
@@ -15,15 +15,49 @@
 
 #include "matching/gpa/path.h"
 #include "matching/gpa/path_set.h"
+#include "matching/gpa/weight_buckets.h"
 
 class gpa: public matching_algorithm {
     public:
         gpa(MatchingConfig &config, bool swaps, bool do_global_swaps, int num_roma)
-            : matching_algorithm(config), swaps(swaps), do_global_swaps(do_global_swaps), num_roma(num_roma)
+            : matching_algorithm(config), swaps(swaps), do_global_swaps(do_global_swaps), num_roma(num_roma),
+            seed(config.seed)
         {}
 
         virtual void run() override;
 
+        virtual matching_algorithm *clone() const override {
+            auto copy = new gpa(config, swaps, do_global_swaps, num_roma);
+            copy->set_seed(seed);
+            return copy;
+        }
+
+        // rounds only depend on the rounds before
+        virtual bool computesMatchingsIncrementally() const noexcept override {
+            return true;
+        }
+
+        // seeded arcs are skipped when building paths, ROMA and swaps
+        // may still replace them
+        virtual bool supportsWarmStart() const noexcept override {
+            return true;
+        }
+
+        // seed for random tie breaking and ROMA, defaults to config.seed
+        void set_seed(int s) {
+            seed = s;
+        }
+
+        int get_seed() const noexcept {
+            return seed;
+        }
+
+        // use a precomputed weight order instead of sorting on each run;
+        // only ties are shuffled then
+        void set_weight_buckets(const weight_buckets *buckets) {
+            shared_buckets = buckets;
+        }
+
         virtual std::string getName() const noexcept override {
             std::ostringstream out;
             out << "GPA";
@@ -59,6 +93,8 @@ class gpa: public matching_algorithm {
 		bool do_global_swaps;
         int num_roma;
 
+        int seed;
+        const weight_buckets *shared_buckets{nullptr};
         std::mt19937 rng;
 
         std::vector<Algora::Vertex*> all_vertices;
@@ -0,0 +1,62 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "matching/gpa/gpa_multi_seed.h"
+
+#include "tools/chronotimer.h"
+#include "tools/parallel.h"
+
+void gpa_multi_seed::setGraph(Algora::DiGraph *g, Algora::FastPropertyMap<EdgeWeight> *w,
+        const Algora::DiGraph::size_type &maxVertexId) {
+    graph = g;
+    weights = w;
+    max_vertex_id = maxVertexId;
+    buckets.reset(new weight_buckets(graph, *weights));
+}
+
+void gpa_multi_seed::solve(unsigned b, int first_seed, unsigned num_seeds, unsigned num_threads) {
+    assert(buckets);
+    results.assign(num_seeds, seed_result());
+
+    // attaching to the graph changes its state, so only run() is parallel
+    std::vector<std::unique_ptr<gpa>> algos;
+    for (auto i = 0U; i < num_seeds; i++) {
+        algos.emplace_back(new gpa(config, swaps, false, num_roma));
+        auto &algo = *algos.back();
+        algo.set_seed(first_seed + static_cast<int>(i));
+        algo.set_weight_buckets(buckets.get());
+        algo.set_max_vertex_id(max_vertex_id);
+        algo.setGraph(graph);
+        algo.setWeights(weights);
+        algo.set_num_matchings(b);
+        results[i].seed = algo.get_seed();
+        results[i].prepared = algo.prepare();
+    }
+
+    parallel_for(num_seeds, num_threads, [&] (size_t i) {
+        auto &result = results[i];
+        if (!result.prepared) {
+            return;
+        }
+        ChronoTimer t;
+        algos[i]->run();
+        result.time = t.elapsed<>();
+        result.weight = algos[i]->deliver();
+    });
+
+    // the smaller seed among equally heavy solutions
+    best_index = results.size();
+    for (auto i = 0UL; i < results.size(); i++) {
+        if (results[i].prepared && (!has_best() || results[i].weight > results[best_index].weight)) {
+            best_index = i;
+        }
+    }
+    best_mate.clear();
+    if (has_best()) {
+        algos[best_index]->swapData(best_edge_color, best_mate);
+    }
+    algos.clear();
+}
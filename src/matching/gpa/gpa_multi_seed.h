@@ -0,0 +1,90 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "matching/gpa/gpa.h"
+#include "matching/gpa/weight_buckets.h"
+
+// Runs GPA (optionally with local swaps or ROMA) for several seeds in
+// parallel. All runs share the read-only graph and one weight order,
+// so each seed only re-shuffles ties.
+class gpa_multi_seed {
+    public:
+        using color_t = matching_algorithm::color_t;
+
+        struct seed_result {
+            int seed{0};
+            bool prepared{false};
+            EdgeWeight weight{0};
+            double time{0.0};
+        };
+
+        gpa_multi_seed(MatchingConfig &config, bool swaps, int num_roma)
+            : config(config), swaps(swaps), num_roma(num_roma) {}
+
+        // sorts the arcs once, needs to be called again if graph or weights change
+        void setGraph(Algora::DiGraph *graph, Algora::FastPropertyMap<EdgeWeight> *weights,
+                const Algora::DiGraph::size_type &max_vertex_id);
+
+        // runs GPA for b matchings with seeds first_seed, ..., first_seed + num_seeds - 1
+        // on up to num_threads threads (0: one per core); the instances are
+        // attached to the graph and prepared one after another, only run()
+        // is parallel
+        void solve(unsigned b, int first_seed, unsigned num_seeds, unsigned num_threads);
+
+        // in the order of the seeds
+        const std::vector<seed_result> &get_results() const noexcept {
+            return results;
+        }
+
+        // whether any seed could be prepared
+        bool has_best() const noexcept {
+            return best_index < results.size();
+        }
+
+        const seed_result &best() const {
+            return results.at(best_index);
+        }
+
+        // coloring and mates of the best seed, taken over from its instance
+        const Algora::FastPropertyMap<color_t> &best_edge_colors() const noexcept {
+            return best_edge_color;
+        }
+
+        const std::vector<Algora::FastPropertyMap<Algora::Vertex*>> &best_mates() const noexcept {
+            return best_mate;
+        }
+
+        std::string getName() const {
+            return gpa(config, swaps, false, num_roma).getName();
+        }
+
+        std::string getShortName() const {
+            return gpa(config, swaps, false, num_roma).getShortName();
+        }
+
+        size_t num_weight_buckets() const {
+            return buckets ? buckets->num_buckets() : 0;
+        }
+
+    private:
+        MatchingConfig &config;
+        bool swaps;
+        int num_roma;
+
+        Algora::DiGraph *graph{nullptr};
+        Algora::FastPropertyMap<EdgeWeight> *weights{nullptr};
+        Algora::DiGraph::size_type max_vertex_id{0};
+        std::unique_ptr<weight_buckets> buckets;
+
+        std::vector<seed_result> results;
+        size_t best_index{0};
+        Algora::FastPropertyMap<color_t> best_edge_color;
+        std::vector<Algora::FastPropertyMap<Algora::Vertex*>> best_mate;
+};
@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "graph/digraph.h"
+#include "property/fastpropertymap.h"
+#include "matching/matching_defs.h"
+
+// Arcs of positive weight sorted by weight descending, grouped into
+// buckets of equal weight. Computed once, it provides GPA's random
+// tie breaking for any number of seeds by shuffling within buckets only.
+// Read-only after construction, so it can be shared among threads.
+class weight_buckets {
+    public:
+        weight_buckets(Algora::DiGraph *graph, Algora::ModifiableProperty<EdgeWeight> &weights) {
+            using namespace Algora;
+            arcs.reserve(graph->getNumArcs(false));
+            graph->mapArcs([this,&weights] (Arc *arc) {
+                if (weights.getValue(arc) > 0) {
+                    arcs.push_back(arc);
+                }
+            });
+            std::sort(arcs.begin(), arcs.end(), [&weights] (const Arc *lop, const Arc *rop) {
+                return weights(lop) > weights(rop);
+            });
+            for (auto i = 0UL; i < arcs.size(); i++) {
+                if (i == 0 || weights(arcs[i]) != weights(arcs[i - 1])) {
+                    bucket_begin.push_back(i);
+                }
+            }
+            bucket_begin.push_back(arcs.size());
+        }
+
+        // arcs in weight order, ties broken randomly using rng
+        template<typename RNG>
+        void shuffled_order(RNG &rng, std::vector<Algora::Arc*> &out) const {
+            out = arcs;
+            for (auto b = 0UL; b + 1 < bucket_begin.size(); b++) {
+                if (bucket_begin[b + 1] - bucket_begin[b] > 1) {
+                    std::shuffle(out.begin() + bucket_begin[b], out.begin() + bucket_begin[b + 1], rng);
+                }
+            }
+        }
+
+        size_t num_arcs() const noexcept {
+            return arcs.size();
+        }
+
+        size_t num_buckets() const noexcept {
+            return bucket_begin.size() - 1;
+        }
+
+    private:
+        std::vector<Algora::Arc*> arcs;
+        std::vector<size_t> bucket_begin;
+};
@@ -16,17 +16,20 @@ void greedy_b_matching::run() {
     edges.reserve(diGraph->getNumArcs(false));
 
     auto *iGraph = dynamic_cast<IncidenceListGraph*>(diGraph);
-    iGraph->mapArcs([this,&edges,iGraph] (Arc * arc) {
-        if (weights->getValue(arc) > 0) {
-            edges.push_back(arc);
-        } else  {
-            iGraph->deactivateArc(arc);
-        }
-    });
+    {
+        DJM_TRACED_PHASE(phase_times, "sort");
+        iGraph->mapArcs([this,&edges,iGraph] (Arc * arc) {
+            if (weights->getValue(arc) > 0) {
+                edges.push_back(arc);
+            } else  {
+                iGraph->deactivateArc(arc);
+            }
+        });
 
-    std::sort(edges.begin(), edges.end(), [this] (const Arc* lop, const Arc* rop) {
-        return weights->getValue(lop) > weights->getValue(rop);
-    });
+        std::sort(edges.begin(), edges.end(), [this] (const Arc* lop, const Arc* rop) {
+            return weights->getValue(lop) > weights->getValue(rop);
+        });
+    }
 
     assert(num_matchings >= 1);
     unsigned b = do_extend ? num_matchings - 1 : num_matchings;
@@ -36,22 +39,34 @@ void greedy_b_matching::run() {
     std::vector<Arc*> unmatched_arcs;
     unmatched_arcs.reserve(edges.size());
     assert(iGraph);
-    for (auto & arc : edges) {
-        if (num_matched[arc->getHead()] < b && num_matched[arc->getTail()] < b) {
-            num_matched[arc->getHead()]++;
-            num_matched[arc->getTail()]++;
-            total_weight += weights->getValue(arc);
-        } else {
-            unmatched_arcs.push_back(arc);
-            iGraph->deactivateArc(arc);
-        }
+    {
+        DJM_TRACED_PHASE(phase_times, "b-matching");
+        prefetched_scan(edges, resolve_endpoints,
+                [&num_matched](const Arc *, const endpoints_t &ends) {
+            DJM_PREFETCH(&num_matched[ends.first]);
+            DJM_PREFETCH(&num_matched[ends.second]);
+        }, [&](Arc *arc, const endpoints_t &ends) {
+            if (num_matched[ends.first] < b && num_matched[ends.second] < b) {
+                num_matched[ends.first]++;
+                num_matched[ends.second]++;
+                total_weight += weights->getValue(arc);
+            } else {
+                unmatched_arcs.push_back(arc);
+                iGraph->deactivateArc(arc);
+            }
+        });
     }
 
     MisraGries mg(config);
-    mg.setGraph(diGraph);
-    mg.setMaxDegree(b);
-    mg.prepare();
-    mg.run();
+    {
+        DJM_TRACED_PHASE(phase_times, "misra-gries");
+        mg.setGraph(diGraph);
+        mg.setMaxDegree(b);
+        mg.prepare();
+        mg.run();
+        phase_times.merge(mg.get_phase_times());
+        events.merge(mg.get_event_counters());
+    }
     std::swap(mate, mg.mate);
     std::swap(edge_color, mg.edge_color);
     // misra gries adds one color, some color will be nullified
@@ -59,6 +74,7 @@ void greedy_b_matching::run() {
     if (!do_extend) {
         num_matchings++;
         if (num_matchings == mg.getNumColors()) {
+            DJM_TRACED_PHASE(phase_times, "postprocess");
             postprocess();
         }
         // discard last color
@@ -71,14 +87,17 @@ void greedy_b_matching::run() {
     }
 
     if (do_extend) {
+        DJM_TRACED_PHASE(phase_times, "extend");
         greedy_extend(unmatched_arcs);
     }
 
     if (do_global_swaps) {
+        DJM_TRACED_PHASE(phase_times, "global swaps");
         global_swaps();
     }
 
-    if (config.sanitycheck) {
+    if (config.sanitycheck && !was_interrupted()) {
+        DJM_TRACED_PHASE(phase_times, "sanity check");
         sanityCheck();
     }
 }
@@ -125,12 +144,15 @@ void greedy_b_matching::greedy_extend(std::vector<Algora::Arc *> &edges) {
     std::vector<Algora::Arc*> remaining_edges;
     remaining_edges.reserve(edges.size());
 	for (auto bi = 0u; bi < num_matchings; bi++) {
-		for (const auto & arc : edges) {
+		prefetched_scan(edges, resolve_endpoints,
+				[this,bi](const Arc *arc, const endpoints_t &ends) {
+			prefetch_round_state(arc, ends, bi);
+		}, [this,bi,&remaining_edges](Arc *arc, const endpoints_t &ends) {
 			if (edge_color[arc] != UNCOLORED) {
-				continue;
+				return;
 			}
-			const auto s = arc->getFirst();
-			const auto t = arc->getSecond();
+			const auto s = ends.first;
+			const auto t = ends.second;
 
 			// can't match edge in this round, as at least one endpoint
 			// is already not free anymore
@@ -142,7 +164,7 @@ void greedy_b_matching::greedy_extend(std::vector<Algora::Arc *> &edges) {
                 edge_color[arc] = bi;
                 total_weight += (*weights)[arc];
             }
-		}
+		});
         std::swap(edges, remaining_edges);
         remaining_edges.clear();
 	}
@@ -15,8 +15,17 @@ class greedy_b_matching : public matching_algorithm {
 
         virtual void run() override final;
 
+        virtual matching_algorithm *clone() const override {
+            return new greedy_b_matching(config, do_extend, do_global_swaps);
+        }
+
         void postprocess();
 
+        // arcs not in the b-matching are deactivated for the coloring
+        virtual bool modifiesGraph() const noexcept override {
+            return true;
+        }
+
         virtual std::string getName() const noexcept override {
             return do_extend
                 ? (do_global_swaps
@@ -5,52 +5,87 @@
  */
 
 #include "greedy_iterative.h"
+#include <algorithm>
 #include <iostream>
 
 void greedy_iterative::run() {
 	using namespace Algora;
 
     std::vector<Arc*> edges;
-    edges.reserve(diGraph->getNumArcs(false));
-	diGraph->mapArcs([this, &edges] (Arc *arc) {
-		if (weights->getValue(arc) > 0) {
-			edges.push_back(arc);
-		}
-	});
+	// the sort takes O(m log m), so the deadline is checked around it
+	if (stop_requested()) {
+		return;
+	}
+	{
+		DJM_TRACED_PHASE(phase_times, "sort");
+		edges.reserve(diGraph->getNumArcs(false));
+		diGraph->mapArcs([this, &edges] (Arc *arc) {
+			if (weights->getValue(arc) > 0) {
+				edges.push_back(arc);
+			}
+		});
 
-	std::sort(edges.begin(), edges.end(), [this](const Arc *lop, const Arc *rop) {
-		return weights->getValue(lop) > weights->getValue(rop);
-	});
+		std::sort(edges.begin(), edges.end(), [this](const Arc *lop, const Arc *rop) {
+			return weights->getValue(lop) > weights->getValue(rop);
+		});
+	}
+	if (stop_requested()) {
+		return;
+	}
 
     std::vector<Algora::Arc*> remaining_edges;
     remaining_edges.reserve(edges.size());
     matched_in_round.reserve(edges.size());
+
+	// with local swaps, arcs may become uncolored again; remember each arc's
+	// position in the weight order so that they can be merged back into the
+	// remaining edges without re-sorting
+	const bool compact_swaps = swaps && !do_global_swaps;
+	if (compact_swaps) {
+		sort_rank.resetAll(diGraph->getNumArcs(false));
+		for (auto i = 0u; i < edges.size(); i++) {
+			sort_rank[edges[i]] = i;
+		}
+	}
 	for (auto bi = 0u; bi < num_matchings; bi++) {
-		for (const auto & arc : edges) {
-			if (edge_color[arc] != UNCOLORED) {
-				continue;
-			}
-			const auto s = arc->getFirst();
-			const auto t = arc->getSecond();
+		if (stop_requested()) {
+			return;
+		}
+		DJM_TRACED_PHASE(phase_times, "round");
+		{
+			DJM_PHASE(phase_times, "scan");
+			prefetched_scan(edges, resolve_endpoints,
+					[this,bi](const Arc *arc, const endpoints_t &ends) {
+				prefetch_round_state(arc, ends, bi);
+			}, [this,bi,&remaining_edges](Arc *arc, const endpoints_t &ends) {
+				if (edge_color[arc] != UNCOLORED) {
+					return;
+				}
+				const auto s = ends.first;
+				const auto t = ends.second;
 
-			// can't match edge in this round, as at least one endpoint
-			// is already not free anymore
-			if (mate[bi][s] != nullptr || mate[bi][t] != nullptr) {
-				remaining_edges.push_back(arc);
-			} else {
-                mate[bi][s] = t;
-                mate[bi][t] = s;
-                edge_color[arc] = bi;
-                total_weight += (*weights)[arc];
-                matched_in_round.push_back(arc);
-            }
+				// can't match edge in this round, as at least one endpoint
+				// is already not free anymore
+				if (mate[bi][s] != nullptr || mate[bi][t] != nullptr) {
+					remaining_edges.push_back(arc);
+				} else {
+	                mate[bi][s] = t;
+	                mate[bi][t] = s;
+	                edge_color[arc] = bi;
+	                total_weight += (*weights)[arc];
+	                matched_in_round.push_back(arc);
+	            }
+			});
 		}
 
-		if (swaps && !do_global_swaps) {
+		if (compact_swaps) {
+			DJM_PHASE(phase_times, "local swaps");
 			bool swapped = local_swaps(bi);
-			// with local swaps instead of re-sorting the shortened edge
-			// vector, keep the complete vector, unless nothing was swapped
-			if (!swapped) {
+			// arcs colored by a swap are dropped from the remaining edges,
+			// arcs uncolored by a swap are merged back in weight order
+			if (swapped) {
+				merge_unmatched_by_swaps(remaining_edges, edges);
+			} else {
                 std::swap(edges, remaining_edges);
 			}
 		} else {
@@ -60,29 +95,73 @@ void greedy_iterative::run() {
 		}
         matched_in_round.clear();
         remaining_edges.clear();
+		if (computesMatchingsIncrementally()) {
+			matching_completed(bi);
+		}
 	}
 
 	if (swaps && do_global_swaps) {
+		DJM_TRACED_PHASE(phase_times, "global swaps");
 		global_swaps();
 	}
 
-	if (config.sanitycheck) {
+	if (config.sanitycheck && !was_interrupted()) {
+		DJM_TRACED_PHASE(phase_times, "sanity check");
 		sanityCheck();
 	}
 }
 
 bool greedy_iterative::local_swaps(const unsigned int round) {
 	using namespace Algora;
-	bool succ = false;
+	unmatched_by_swaps.clear();
 	if (config.swaps_reverse_sort) {
         for (auto it = matched_in_round.rbegin(); it != matched_in_round.rend(); it++) {
-            succ |= swap_subroutine(*it, round);
+            if (swap_subroutine(*it, round)) {
+                unmatched_by_swaps.push_back(*it);
+            }
         }
     } else {
         for (auto *arc : matched_in_round) {
-            succ |= swap_subroutine(arc, round);
+            if (swap_subroutine(arc, round)) {
+                unmatched_by_swaps.push_back(arc);
+            }
         }
     }
-	return succ;
+	return !unmatched_by_swaps.empty();
+}
+
+// merges the arcs uncolored by local swaps back into the remaining edges,
+// such that target holds exactly the uncolored arcs in their original order
+void greedy_iterative::merge_unmatched_by_swaps(const std::vector<Algora::Arc*> &remaining,
+		std::vector<Algora::Arc*> &target) {
+	using namespace Algora;
+	auto by_rank = [this](const Arc *lop, const Arc *rop) {
+		return sort_rank(lop) < sort_rank(rop);
+	};
+	// matched_in_round is in weight order, so this is sorted already,
+	// unless the swaps went through it in reverse
+	if (config.swaps_reverse_sort) {
+		std::reverse(unmatched_by_swaps.begin(), unmatched_by_swaps.end());
+	}
+	assert(std::is_sorted(unmatched_by_swaps.begin(), unmatched_by_swaps.end(), by_rank));
+	unmatched_by_swaps.erase(std::remove_if(unmatched_by_swaps.begin(), unmatched_by_swaps.end(),
+				[this](const Arc *arc) { return edge_color(arc) != UNCOLORED; }),
+			unmatched_by_swaps.end());
+
+	target.clear();
+	auto side = unmatched_by_swaps.cbegin();
+	for (auto *arc : remaining) {
+		// arc was colored by a swap in this round
+		if (edge_color[arc] != UNCOLORED) {
+			continue;
+		}
+		while (side != unmatched_by_swaps.cend() && by_rank(*side, arc)) {
+			target.push_back(*side);
+			side++;
+		}
+		target.push_back(arc);
+	}
+	target.insert(target.end(), side, unmatched_by_swaps.cend());
+	unmatched_by_swaps.clear();
 }
 
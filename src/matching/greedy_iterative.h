@@ -16,6 +16,21 @@ class greedy_iterative : public matching_algorithm {
 
 		void run() override final;
 
+		matching_algorithm *clone() const override {
+			return new greedy_iterative(config, swaps, do_global_swaps);
+		}
+
+		// rounds only depend on the rounds before, unless global swaps
+		// change all matchings afterwards
+		bool computesMatchingsIncrementally() const noexcept override {
+			return !(swaps && do_global_swaps);
+		}
+
+		// seeded arcs count as matched in the first rounds already
+		bool supportsWarmStart() const noexcept override {
+			return true;
+		}
+
 		std::string getName() const noexcept override {
 			std::string app = "";
 			if (swaps) {
@@ -37,6 +52,10 @@ class greedy_iterative : public matching_algorithm {
 		bool swaps;
 		bool do_global_swaps;
 		std::vector<Algora::Arc*> matched_in_round;
+		std::vector<Algora::Arc*> unmatched_by_swaps;
+		Algora::FastPropertyMap<unsigned> sort_rank;
 
 		bool local_swaps(const unsigned int round);
+		void merge_unmatched_by_swaps(const std::vector<Algora::Arc*> &remaining,
+				std::vector<Algora::Arc*> &target);
 };
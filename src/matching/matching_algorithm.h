@@ -5,11 +5,18 @@
  */
 
 #pragma once
+#include <atomic>
+#include <functional>
 #include <string>
 #include <iostream>
 #include <limits>
+#include <vector>
 #include "matching_config.h"
 #include "matching_defs.h"
+#include "event_counters.h"
+#include "prefetch_scan.h"
+#include "solution_io.h"
+#include "tools/chronotimer.h"
 #include "algorithm/dynamicweighteddigraphalgorithm.h"
 
 #include "graph/digraph.h"
@@ -51,6 +58,12 @@ class matching_algorithm :
             max_vertex_id = maxVertexId;
         }
 
+        // new instance with the same parameters but without any state,
+        // nullptr if not supported
+        virtual matching_algorithm *clone() const {
+            return nullptr;
+        }
+
         virtual EdgeWeight deliver() {
             return total_weight;
         }
@@ -59,14 +72,114 @@ class matching_algorithm :
             return -1.0;
         }
 
+        // whether run() temporarily changes the graph, e.g., by
+        // deactivating arcs; such algorithms can't share the graph
+        // with concurrently running ones
+        virtual bool modifiesGraph() const noexcept {
+            return false;
+        }
+
         Algora::FastPropertyMap<color_t> getEdgeColors() {
             return edge_color;
         }
 
+        // mate of v in matching c, nullptr if unmatched
+        Algora::Vertex *getMate(const color_t &c, const Algora::Vertex *v) const {
+            return mate[c](v);
+        }
+
+        // whether arc is in one of the matchings of the current solution
+        bool isMatched(const Algora::Arc *arc) const {
+            return edge_color(arc) != UNCOLORED;
+        }
+
+        // index of the matching arc is in, if isMatched(arc)
+        color_t getEdgeColor(const Algora::Arc *arc) const {
+            return edge_color(arc);
+        }
+
         std::vector<Algora::FastPropertyMap<Algora::Vertex*>> getMates() {
             return mate;
         }
 
+        // copy of the mates in matching c
+        Algora::FastPropertyMap<Algora::Vertex*> getMates(const color_t &c) const {
+            return mate[c];
+        }
+
+        // cooperative cancellation: once *flag is set, run() returns
+        // at its next cancellation point, leaving a valid, but possibly
+        // incomplete solution behind
+        void set_stop_flag(const std::atomic<bool> *flag) {
+            stop_flag = flag;
+        }
+
+        // whether the last run() returned early due to the stop flag
+        bool was_interrupted() const noexcept {
+            return interrupted;
+        }
+
+        // listener is called with the index of each matching as soon as
+        // the matching is final, i.e., before run() returns if the
+        // algorithm computesMatchingsIncrementally()
+        using matching_listener = std::function<void(const color_t&)>;
+        void set_matching_listener(const matching_listener &listener) {
+            on_matching_completed = listener;
+        }
+
+        // whether the matchings are computed one after another, such that
+        // each matching is final before the next one is computed and the
+        // first b' matchings for any b > b' are the solution for b'
+        virtual bool computesMatchingsIncrementally() const noexcept {
+            return false;
+        }
+
+        // warm start: after each reset, the links of solution are colored
+        // before the algorithm runs; links whose arc does not exist or has
+        // zero weight, whose color is >= b, or that conflict with a link
+        // colored before are skipped
+        // only has an effect if the algorithm supportsWarmStart()
+        void set_warm_start(const std::vector<solution_link> *solution) {
+            warm_start = solution;
+        }
+
+        virtual bool supportsWarmStart() const noexcept {
+            return false;
+        }
+
+        // number of links colored from the warm start by the last reset
+        unsigned long num_warm_start_arcs() const noexcept {
+            return warm_started.size();
+        }
+
+        // number of links colored from the warm start that still have
+        // the same color
+        unsigned long num_unchanged_warm_start_arcs() const {
+            auto unchanged = 0UL;
+            for (const auto &seeded : warm_started) {
+                if (edge_color(seeded.first) == seeded.second) {
+                    unchanged++;
+                }
+            }
+            return unchanged;
+        }
+
+        // times of the phases of the last prepare() and run()
+        const PhaseTimes &get_phase_times() const noexcept {
+            return phase_times;
+        }
+
+        // events of the last prepare() and run(), e.g., swaps
+        const event_counters &get_event_counters() const noexcept {
+            return events;
+        }
+
+        // hardware counters of the thread running the algorithm to record
+        // per phase, nullptr for times only
+        void set_perf_counters(const PerfCounters *counters) {
+            phase_times.set_counters(counters);
+        }
+
         void swapData(Algora::FastPropertyMap<color_t> &edge_colors,
                 std::vector<Algora::FastPropertyMap<Algora::Vertex*>> &mates) {
             std::swap(edge_colors, this->edge_color);
@@ -82,10 +195,33 @@ class matching_algorithm :
         std::vector<Algora::FastPropertyMap<Algora::Vertex*>> mate;
         std::vector<Algora::FastPropertyMap<Algora::Arc*>> arcToMate;
         EdgeWeight total_weight{0ul};
+        const std::atomic<bool> *stop_flag{nullptr};
+        bool interrupted{false};
+        const std::vector<solution_link> *warm_start{nullptr};
+        std::vector<std::pair<Algora::Arc*, color_t>> warm_started;
+
+        matching_listener on_matching_completed;
+        PhaseTimes phase_times;
+        event_counters events;
+
+        void matching_completed(const color_t &c) {
+            if (on_matching_completed) {
+                on_matching_completed(c);
+            }
+        }
+
+        // cancellation point
+        bool stop_requested() {
+            if (!interrupted && stop_flag != nullptr
+                    && stop_flag->load(std::memory_order_relaxed)) {
+                interrupted = true;
+            }
+            return interrupted;
+        }
 
 #ifdef SHADOW
-        FastPropertyMap<EdgeWeight> *weights;
-        IncidenceListGraph *diGraph;
+        FastPropertyMap<EdgeWeight> *weights{nullptr};
+        IncidenceListGraph *diGraph{nullptr};
 
         virtual void onWeightsSet() override {
             Super::onWeightsSet();
@@ -105,6 +241,9 @@ class matching_algorithm :
         }
 
         void reset() {
+            interrupted = false;
+            phase_times.clear();
+            events.clear();
             if (num_matchings == 0) {
                 return;
             }
@@ -117,6 +256,43 @@ class matching_algorithm :
                 arcToMate[bi].resetAll(max_vertex_id);
             }
             total_weight = 0;
+            warm_started.clear();
+            if (warm_start != nullptr && supportsWarmStart() && weights != nullptr) {
+                apply_warm_start();
+            }
+        }
+
+        void apply_warm_start() {
+            std::vector<Vertex*> vertex_of_id(max_vertex_id, nullptr);
+            diGraph->mapVertices([&vertex_of_id] (Vertex *v) {
+                if (v->getId() >= vertex_of_id.size()) {
+                    vertex_of_id.resize(v->getId() + 1, nullptr);
+                }
+                vertex_of_id[v->getId()] = v;
+            });
+            for (const auto &link : *warm_start) {
+                if (link.color >= num_matchings || link.tail >= vertex_of_id.size()
+                        || link.head >= vertex_of_id.size()) {
+                    continue;
+                }
+                const auto s = vertex_of_id[link.tail];
+                const auto t = vertex_of_id[link.head];
+                if (s == nullptr || t == nullptr || s == t
+                        || mate[link.color][s] != nullptr || mate[link.color][t] != nullptr) {
+                    continue;
+                }
+                // prefer the arc in the given direction
+                auto arc = diGraph->findArc(s, t);
+                if (arc == nullptr || weights->getValue(arc) == 0 || edge_color(arc) != UNCOLORED) {
+                    arc = diGraph->findArc(t, s);
+                }
+                if (arc == nullptr || weights->getValue(arc) == 0 || edge_color(arc) != UNCOLORED) {
+                    continue;
+                }
+                set_edge_color(arc, link.color);
+                total_weight += weights->getValue(arc);
+                warm_started.emplace_back(arc, link.color);
+            }
         }
 
         void set_edge_color(Arc *a, const color_t &c) {
@@ -150,6 +326,25 @@ class matching_algorithm :
         }
 
 
+        using endpoints_t = std::pair<Algora::Vertex*, Algora::Vertex*>;
+
+        // first stage of a prefetched scan: endpoints of an arc
+        static endpoints_t resolve_endpoints(const Algora::Arc *a) {
+            const auto s = a->getFirst();
+            const auto t = a->getSecond();
+            DJM_PREFETCH(s);
+            DJM_PREFETCH(t);
+            return { s, t };
+        }
+
+        // second stage of a prefetched scan: color of an arc and
+        // mates of its endpoints in the given round
+        void prefetch_round_state(const Algora::Arc *a, const endpoints_t &ends, const color_t &round) {
+            DJM_PREFETCH(&edge_color[a]);
+            DJM_PREFETCH(&mate[round][ends.first]);
+            DJM_PREFETCH(&mate[round][ends.second]);
+        }
+
         color_t matching_free_color(const Algora::Vertex *lop, const Algora::Vertex *rop) {
             color_t i = 0;
             for (; i < mate.size(); i++) {
@@ -272,6 +467,7 @@ class matching_algorithm :
             outgoing = false;
             diGraph->mapIncomingArcs(t,vm);
 
+            events.count(event_type::SWAPS_ATTEMPTED);
             if (lop_weight > 0 && rop_weight > 0 && (lop_weight+rop_weight) > (*weights)[arc]) {
                 // replace arc with lop and rop
                 const auto s1 = lop->getFirst();
@@ -294,6 +490,7 @@ class matching_algorithm :
                 edge_color[arc] = UNCOLORED;
 
                 total_weight = total_weight - (*weights)[arc] + (*weights)[lop] + (*weights)[rop];
+                events.count(event_type::SWAPS_SUCCESSFUL);
                 return true;
             }
             return false;
@@ -320,6 +517,9 @@ class matching_algorithm :
             }
         
         	for (const auto & arc : edges) {
+                if (stop_requested()) {
+                    return;
+                }
         		auto round = matching_free_color(arc->getFirst(), arc->getSecond());
         		if (round < num_matchings) {
                         swap_subroutine(arc, round);
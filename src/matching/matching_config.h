@@ -43,6 +43,69 @@ struct MatchingConfig {
     int seed{123};
     unsigned algorithm_order_seed{0};
 
+    // number of algorithms to run concurrently, 0 = one per core
+    unsigned parallel_algorithms{1};
+
+    // number of threads for parallel modes, 0 = one per core
+    unsigned threads{0};
+
+    // wall-clock budget per b for the anytime portfolio, 0 = off
+    unsigned portfolio_deadline_ms{0};
+
+    // number of seeds for parallel multi-seed GPA, 0 = off
+    unsigned gpa_seeds{0};
+
+    // file receiving the solution of each algorithm, empty = none
+    std::string solution_output = "";
+    bool solution_binary{false};
+    bool solution_mmap{false};
+
+    // file or FIFO receiving each matching as soon as it is final, empty = none
+    std::string stream_matchings = "";
+
+    // merge antiparallel and parallel arcs at load time
+    NormalizeType normalize{NO_NORMALIZE};
+    // renumbering of the vertices of the normalized graph
+    VertexOrder vertex_order{INPUT_ORDER};
+
+    // solve each connected component separately, on threads threads
+    bool components{false};
+
+    // compute all b at once for algorithms that compute matchings incrementally
+    bool incremental_b{false};
+
+    // repair solutions under all further deltas of the input
+    bool dynamic{false};
+
+    // streaming mode: length and slide of the time window over the
+    // timestamps of the input, length 0 = off
+    unsigned long long window_length{0};
+    unsigned long long window_slide{0};
+    // file receiving the matching of each window, empty = none
+    std::string window_output = "";
+
+    // cost per link changed by repairs in dynamic and streaming mode
+    EdgeWeight switch_penalty{0};
+    // file receiving the per-matching diff of each repair, empty = none
+    std::string diff_output = "";
+
+    // solution to warm-start the algorithms from, empty = none
+    std::string warm_start_file = "";
+
+    // print the time per phase of each algorithm below its result
+    bool phase_times{false};
+    // file receiving the time per phase of each algorithm, empty = none
+    std::string phase_output = "";
+    // record hardware counters per algorithm and phase
+    bool perf_counters{false};
+    // print swaps, fan sizes, path lengths, ... of each algorithm below its result
+    bool event_counters{false};
+    // compute upper bounds on the optimum per b and compare each weight to them
+    bool upper_bounds{false};
+
+    // file receiving a timeline of the phases per thread, empty = none
+    std::string trace_output = "";
+
     std::vector<MatchingAlgorithm> algorithms;
     std::vector<AggregateType> aggregation_types;
 };
@@ -7,6 +7,11 @@
 #pragma once
 
 enum AggregateType {SUM,MAX,AVG,MEDIAN,B_SUM};
+// how to combine the weights of antiparallel and parallel arcs when
+// normalizing the input
+enum NormalizeType {NO_NORMALIZE, NORMALIZE_SUM, NORMALIZE_MAX};
+// order in which the vertices of the normalized graph are numbered
+enum VertexOrder {INPUT_ORDER, DEGREE_ORDER, RCM_ORDER, COMMUNITY_ORDER};
 enum MatchingAlgorithm {BGREEDY_COLOR, BGREEDY_EXTEND, GREEDY_IT, GPA_IT, NODE_CENTERED, K_EC };
 
 typedef unsigned long int EdgeWeight;
@@ -0,0 +1,119 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "matching/matching_stream.h"
+
+matching_stream::matching_stream(const std::string &filename)
+    : out(filename) {
+    if (out.is_open()) {
+        writer = std::thread([this] () { write_all(); });
+    }
+}
+
+matching_stream::~matching_stream() {
+    queue.close();
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+void matching_stream::attach(matching_algorithm &algo, Algora::DiGraph *graph,
+        Algora::FastPropertyMap<EdgeWeight> *weights, unsigned b,
+        const std::string &header) {
+    this->algo = &algo;
+    this->graph = graph;
+    this->weights = weights;
+    num_matchings = b;
+    num_published = 0;
+    published_weight = 0;
+    pending_header = header;
+    if (algo.computesMatchingsIncrementally()) {
+        // runs on the thread of the algorithm
+        algo.set_matching_listener([this] (const matching_algorithm::color_t &c) {
+            const auto total = this->algo->deliver();
+            publish(c, total - published_weight);
+            published_weight = total;
+        });
+    }
+}
+
+void matching_stream::detach() {
+    using namespace Algora;
+    if (algo == nullptr) {
+        return;
+    }
+    algo->set_matching_listener(nullptr);
+    if (num_published < num_matchings) {
+        std::vector<EdgeWeight> color_weights(num_matchings, 0);
+        graph->mapArcs([this,&color_weights] (Arc *arc) {
+            if (algo->isMatched(arc)) {
+                color_weights[algo->getEdgeColor(arc)] += weights->getValue(arc);
+            }
+        });
+        for (auto c = num_published; c < num_matchings; c++) {
+            publish(c, color_weights[c]);
+        }
+    }
+    algo = nullptr;
+    if (!writer.joinable()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(written_mutex);
+    all_written.wait(lock, [this] () { return num_written == num_pushed; });
+}
+
+void matching_stream::publish(const matching_algorithm::color_t &c, const EdgeWeight &weight) {
+    published_matching matching;
+    matching.header.swap(pending_header);
+    matching.color = c;
+    matching.weight = weight;
+    matching.graph = graph;
+    matching.mates = algo->getMates(c);
+    {
+        std::lock_guard<std::mutex> lock(written_mutex);
+        num_pushed++;
+    }
+    queue.push(std::move(matching));
+    num_published = c + 1;
+}
+
+void matching_stream::write_all() {
+    using namespace Algora;
+    auto id = [this] (const Vertex *v) {
+        return vertex_ids ? (*vertex_ids)[v->getId()] : v->getId();
+    };
+    published_matching matching;
+    // mate id per vertex id, -1 if unmatched
+    std::vector<long long> mates;
+    while (queue.pop(matching)) {
+        mates.clear();
+        matching.graph->mapVertices([&matching,&mates,&id] (Vertex *v) {
+            auto m = matching.mates(v);
+            if (id(v) >= mates.size()) {
+                mates.resize(id(v) + 1, -1);
+            }
+            if (m != nullptr) {
+                mates[id(v)] = id(m);
+            }
+        });
+        if (!matching.header.empty()) {
+            out << "% " << matching.header << "\n";
+        }
+        out << "% matching " << matching.color << " weight " << matching.weight << "\n";
+        for (auto u = 0UL; u < mates.size(); u++) {
+            if (mates[u] > static_cast<long long>(u)) {
+                out << u << " " << mates[u] << "\n";
+            }
+        }
+        // consumers may be waiting for this matching
+        out.flush();
+        {
+            std::lock_guard<std::mutex> lock(written_mutex);
+            num_written++;
+        }
+        all_written.notify_all();
+    }
+}
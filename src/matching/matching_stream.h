@@ -0,0 +1,82 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "matching/matching_algorithm.h"
+#include "tools/blocking_queue.h"
+
+// Publishes each matching of an algorithm as soon as it is final and
+// writes it to a file or FIFO on a separate thread, so that consumers can
+// start working on the first matchings while the algorithm is still
+// computing the later ones.
+// For algorithms that compute their matchings incrementally, matchings
+// are published from the matching listener during run(); for all others,
+// they are published at once by detach().
+// Publishing only copies the mates of the matching, they are translated
+// into vertex ids and written by the writer thread.
+// Output per matching: a line "% matching <c> weight <w>" followed by one
+// line "u v" per matched pair (u < v), vertex ids as in the graph.
+class matching_stream {
+    public:
+        struct published_matching {
+            // header line written before the matching, if not empty
+            std::string header;
+            matching_algorithm::color_t color;
+            EdgeWeight weight;
+            Algora::DiGraph *graph;
+            Algora::FastPropertyMap<Algora::Vertex*> mates;
+        };
+
+        matching_stream(const std::string &filename);
+        ~matching_stream();
+
+        bool is_open() const {
+            return out.is_open();
+        }
+
+        // publishes the b matchings of the next run of algo, preceded by header
+        void attach(matching_algorithm &algo, Algora::DiGraph *graph,
+                Algora::FastPropertyMap<EdgeWeight> *weights, unsigned b,
+                const std::string &header);
+
+        // publishes all matchings of algo that have not been published yet
+        // and waits until all of them are written, as the writer reads the
+        // graph, which may change afterwards
+        void detach();
+
+        // input vertex id per vertex id, nullptr = the vertex ids themselves
+        void set_vertex_ids(const std::vector<unsigned long> *ids) {
+            vertex_ids = ids;
+        }
+
+    private:
+        std::ofstream out;
+        blocking_queue<published_matching> queue;
+        std::thread writer;
+        std::mutex written_mutex;
+        std::condition_variable all_written;
+        unsigned long num_pushed{0};
+        unsigned long num_written{0};
+
+        matching_algorithm *algo{nullptr};
+        Algora::DiGraph *graph{nullptr};
+        Algora::FastPropertyMap<EdgeWeight> *weights{nullptr};
+        const std::vector<unsigned long> *vertex_ids{nullptr};
+        unsigned num_matchings{0};
+        unsigned num_published{0};
+        EdgeWeight published_weight{0};
+        std::string pending_header;
+
+        void publish(const matching_algorithm::color_t &c, const EdgeWeight &weight);
+        void write_all();
+};
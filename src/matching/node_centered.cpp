@@ -16,6 +16,13 @@ void node_centered::run() {
 	FastPropertyMap<EdgeWeight> node_weights(0, "", max_vertex_id);
 	std::vector<Vertex*> nodes;
     nodes.reserve(diGraph->getSize());
+	// sorting the incident arcs and the nodes takes O(m log m) in total,
+	// so the deadline is checked around both
+	if (stop_requested()) {
+		return;
+	}
+	{
+	DJM_TRACED_PHASE(phase_times, "aggregate");
 	diGraph->mapVertices([this,&nodes,&node_weights,&global_max,&edges] (Vertex* v) {
         edges[v].reserve(diGraph->getDegree(v,false));
 	    auto am = [this,v,&edges] (Arc * arc) {
@@ -36,10 +43,20 @@ void node_centered::run() {
         }
 		node_weights[v] = edges[v].empty() ? 0 : aggregateWeights(edges[v], *weights);
 	});
+	}
 
+	if (stop_requested()) {
+		return;
+	}
+	{
+	DJM_TRACED_PHASE(phase_times, "sort");
 	std::sort(nodes.begin(), nodes.end(), [&node_weights](Vertex * lop, Vertex * rop) {
 		return node_weights[lop] > node_weights[rop];
 	});
+	}
+	if (stop_requested()) {
+		return;
+	}
 
 	EdgeWeight global_threshold = threshold > 0 ? global_max * threshold : 0;
 
@@ -47,7 +64,25 @@ void node_centered::run() {
 
 	FastPropertyMap<std::vector<char>> free_colors(std::vector<char>(num_matchings, true), "", max_vertex_id);
 
+	// arcs colored by a warm start
+	if (num_warm_start_arcs() > 0) {
+		diGraph->mapArcs([this,&num_matching,&free_colors](Arc *arc) {
+			const auto color = edge_color[arc];
+			if (color < num_matchings) {
+				num_matching[arc->getFirst()]++;
+				free_colors[arc->getFirst()][color] = false;
+				num_matching[arc->getSecond()]++;
+				free_colors[arc->getSecond()][color] = false;
+			}
+		});
+	}
+
+	{
+	DJM_TRACED_PHASE(phase_times, "node scan");
 	for (const auto &v : nodes) {
+		if (stop_requested()) {
+			return;
+		}
 		for (const auto &arc : edges[v]) {
 			if (num_matching[v] >= num_matchings || weights->getValue(arc) < global_threshold) {
 				break;
@@ -71,8 +106,10 @@ void node_centered::run() {
 			}
 		}
 	}
+	}
 
 	if (threshold > 0) {
+		DJM_TRACED_PHASE(phase_times, "fill up");
 		std::vector<Arc*> left_edges;
 		diGraph->mapArcs([this,&num_matching,&left_edges](Arc* arc) {
 			if (edge_color[arc] < num_matchings) {
@@ -90,6 +127,9 @@ void node_centered::run() {
 		});
 
 		for (const auto & arc : left_edges) {
+			if (stop_requested()) {
+				return;
+			}
 			const auto s = arc->getFirst();
 			const auto t = arc->getSecond();
 			if (num_matching[s] >= num_matchings
@@ -107,11 +147,15 @@ void node_centered::run() {
 				num_matching[t]++;
 
 				total_weight += weights->getValue(arc);
+
+				mate[color][s] = t;
+				mate[color][t] = s;
 			}
 		}
 	}
 
 	if (config.sanitycheck) {
+		DJM_TRACED_PHASE(phase_times, "sanity check");
 		sanityCheck();
 	}
 }
@@ -14,6 +14,7 @@
 
 
 const std::string aggregate_names[] = {"SUM", "MAX", "AVG", "MEDIAN", "B_SUM"};
+
 class node_centered : public matching_algorithm {
 
 	public:
@@ -22,6 +23,15 @@ class node_centered : public matching_algorithm {
 
 		virtual void run() override final;
 
+		virtual matching_algorithm *clone() const override {
+			return new node_centered(config, type, threshold);
+		}
+
+		// seeded arcs occupy their color at both endpoints
+		virtual bool supportsWarmStart() const noexcept override {
+			return true;
+		}
+
 		virtual std::string getName() const noexcept override {
             std::ostringstream out;
             out << "node_centered-" << aggregate_names[type];
@@ -44,6 +54,14 @@ class node_centered : public matching_algorithm {
             return threshold;
         }
 
+        // index of the first color free in both lop and rop, lop.size() if none
+        static unsigned first_free_matching_color(const std::vector<char> & lop, const std::vector<char> & rop) {
+            return std::mismatch(
+                    lop.begin(), lop.end(),
+                    rop.begin(), rop.end(),
+                    [](const char &l, const char &r){ return !(l && r);}).first - lop.begin();
+        }
+
 	private:
 		AggregateType type;
 		double threshold {-1.0};
@@ -107,13 +125,6 @@ class node_centered : public matching_algorithm {
             }
         }
 
-        unsigned first_free_matching_color(const std::vector<char> & lop, const std::vector<char> & rop) {
-            return std::mismatch(
-                    lop.begin(), lop.end(),
-                    rop.begin(), rop.end(),
-                    [](const char &l, const char &r){ return !(l && r);}).first - lop.begin();
-        }
-
         unsigned first_free(const std::vector<char> & lop) {
             return std::find(lop.begin(), lop.end(), true) - lop.begin();
         }
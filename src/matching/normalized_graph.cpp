@@ -0,0 +1,325 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "matching/normalized_graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <numeric>
+
+#include "tools/parallel.h"
+
+namespace {
+
+const auto CHUNK_SIZE = 1UL << 14;
+
+struct edge {
+    unsigned long other;
+    EdgeWeight weight;
+};
+
+// u < v
+struct edge_triple {
+    unsigned long u;
+    unsigned long v;
+    EdgeWeight weight;
+};
+
+// edges [begin[u], begin[u] + size[u]) are those of u with a larger
+// endpoint, sorted by that endpoint
+struct edge_buckets {
+    std::vector<unsigned long> begin;
+    std::vector<unsigned long> size;
+    std::vector<edge> edges;
+
+    unsigned long num_edges() const {
+        return std::accumulate(size.begin(), size.end(), 0UL);
+    }
+};
+
+// buckets triples by u (count, prefix sums, scatter) and merges those
+// with the same endpoints per bucket, all in parallel
+edge_buckets bucket_edges(unsigned long n, const std::vector<edge_triple> &triples,
+        NormalizeType combine, unsigned threads) {
+    edge_buckets buckets;
+    std::vector<std::atomic<unsigned long>> next(n);
+    for (auto &d : next) {
+        d.store(0, std::memory_order_relaxed);
+    }
+    const auto num_chunks = (triples.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    parallel_for(num_chunks, threads, [&] (std::size_t c) {
+        const auto end = std::min(triples.size(), (c + 1) * CHUNK_SIZE);
+        for (auto i = c * CHUNK_SIZE; i < end; i++) {
+            next[triples[i].u].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // next[u] becomes the next free slot of u
+    buckets.begin.assign(n + 1, 0);
+    for (auto u = 0UL; u < n; u++) {
+        buckets.begin[u + 1] = buckets.begin[u] + next[u].load(std::memory_order_relaxed);
+        next[u].store(buckets.begin[u], std::memory_order_relaxed);
+    }
+    buckets.edges.resize(triples.size());
+    parallel_for(num_chunks, threads, [&] (std::size_t c) {
+        const auto end = std::min(triples.size(), (c + 1) * CHUNK_SIZE);
+        for (auto i = c * CHUNK_SIZE; i < end; i++) {
+            const auto &t = triples[i];
+            buckets.edges[next[t.u].fetch_add(1, std::memory_order_relaxed)] = {t.v, t.weight};
+        }
+    });
+
+    buckets.size.assign(n, 0);
+    const auto vertex_chunk = 1UL << 12;
+    parallel_for((n + vertex_chunk - 1) / vertex_chunk, threads, [&] (std::size_t c) {
+        const auto end = std::min<unsigned long>(n, (c + 1) * vertex_chunk);
+        for (auto u = c * vertex_chunk; u < end; u++) {
+            auto first = buckets.edges.begin() + buckets.begin[u];
+            auto last = buckets.edges.begin() + buckets.begin[u + 1];
+            std::sort(first, last, [] (const edge &lop, const edge &rop) {
+                return lop.other < rop.other;
+            });
+            auto out = first;
+            for (auto it = first; it != last; ++it) {
+                if (out != first && (out - 1)->other == it->other) {
+                    auto &w = (out - 1)->weight;
+                    w = combine == NORMALIZE_MAX ? std::max(w, it->weight) : w + it->weight;
+                } else {
+                    *out++ = *it;
+                }
+            }
+            buckets.size[u] = out - first;
+        }
+    });
+    return buckets;
+}
+
+// both directions of all edges, adjacency of x is [begin[x], begin[x + 1])
+struct adjacency {
+    std::vector<unsigned long> begin;
+    std::vector<edge> neighbors;
+
+    unsigned long degree(unsigned long x) const {
+        return begin[x + 1] - begin[x];
+    }
+};
+
+adjacency undirected_adjacency(unsigned long n, const edge_buckets &buckets) {
+    adjacency adj;
+    std::vector<unsigned long> next(n + 1, 0);
+    for (auto u = 0UL; u < n; u++) {
+        next[u] += buckets.size[u];
+        for (auto i = buckets.begin[u]; i < buckets.begin[u] + buckets.size[u]; i++) {
+            next[buckets.edges[i].other]++;
+        }
+    }
+    adj.begin.assign(n + 1, 0);
+    for (auto x = 0UL; x < n; x++) {
+        adj.begin[x + 1] = adj.begin[x] + next[x];
+        next[x] = adj.begin[x];
+    }
+    adj.neighbors.resize(adj.begin[n]);
+    for (auto u = 0UL; u < n; u++) {
+        for (auto i = buckets.begin[u]; i < buckets.begin[u] + buckets.size[u]; i++) {
+            const auto &e = buckets.edges[i];
+            adj.neighbors[next[u]++] = e;
+            adj.neighbors[next[e.other]++] = {u, e.weight};
+        }
+    }
+    return adj;
+}
+
+std::vector<unsigned long> by_degree(const adjacency &adj, unsigned long n, bool descending) {
+    std::vector<unsigned long> ids(n);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::stable_sort(ids.begin(), ids.end(), [&adj,descending] (unsigned long lop, unsigned long rop) {
+        return descending ? adj.degree(lop) > adj.degree(rop) : adj.degree(lop) < adj.degree(rop);
+    });
+    return ids;
+}
+
+std::vector<unsigned long> reverse_cuthill_mckee(const adjacency &adj, unsigned long n) {
+    std::vector<unsigned long> order;
+    order.reserve(n);
+    std::vector<char> visited(n, false);
+    std::vector<unsigned long> next_level;
+    for (auto s : by_degree(adj, n, false)) {
+        if (visited[s]) {
+            continue;
+        }
+        visited[s] = true;
+        auto head = order.size();
+        order.push_back(s);
+        while (head < order.size()) {
+            const auto x = order[head++];
+            next_level.clear();
+            for (auto i = adj.begin[x]; i < adj.begin[x + 1]; i++) {
+                const auto y = adj.neighbors[i].other;
+                if (!visited[y]) {
+                    visited[y] = true;
+                    next_level.push_back(y);
+                }
+            }
+            std::stable_sort(next_level.begin(), next_level.end(), [&adj] (unsigned long lop, unsigned long rop) {
+                return adj.degree(lop) < adj.degree(rop);
+            });
+            order.insert(order.end(), next_level.begin(), next_level.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+std::vector<unsigned long> community_order(const adjacency &adj, unsigned long n) {
+    const auto max_rounds = 10U;
+    std::vector<unsigned long> label(n);
+    std::iota(label.begin(), label.end(), 0);
+    std::vector<EdgeWeight> label_weight(n, 0);
+    std::vector<unsigned long> seen;
+
+    // weighted label propagation, heavy vertices first
+    const auto ids = by_degree(adj, n, true);
+    for (auto round = 0U; round < max_rounds; round++) {
+        auto changes = 0UL;
+        for (auto x : ids) {
+            seen.clear();
+            for (auto i = adj.begin[x]; i < adj.begin[x + 1]; i++) {
+                const auto l = label[adj.neighbors[i].other];
+                if (label_weight[l] == 0) {
+                    seen.push_back(l);
+                }
+                label_weight[l] += adj.neighbors[i].weight;
+            }
+            auto best = label[x];
+            for (auto l : seen) {
+                if (label_weight[l] > label_weight[best] || (label_weight[l] == label_weight[best] && l < best)) {
+                    best = l;
+                }
+            }
+            for (auto l : seen) {
+                label_weight[l] = 0;
+            }
+            if (best != label[x]) {
+                label[x] = best;
+                changes++;
+            }
+        }
+        if (changes == 0) {
+            break;
+        }
+    }
+
+    // communities in the order their heaviest vertex appears
+    std::vector<unsigned long> rank(n, n);
+    auto next_rank = 0UL;
+    for (auto x : ids) {
+        if (rank[label[x]] == n) {
+            rank[label[x]] = next_rank++;
+        }
+    }
+    auto order = ids;
+    std::stable_sort(order.begin(), order.end(), [&rank,&label] (unsigned long lop, unsigned long rop) {
+        return rank[label[lop]] < rank[label[rop]];
+    });
+    return order;
+}
+
+}
+
+void normalized_graph::build(Algora::DiGraph *input, Algora::FastPropertyMap<EdgeWeight> *input_weights,
+        Algora::DiGraph::size_type max_vertex_id, unsigned threads) {
+    using namespace Algora;
+    assert(graph.isEmpty());
+    const auto n = max_vertex_id;
+
+    std::vector<Arc*> arcs;
+    arcs.reserve(input->getNumArcs(false));
+    input->mapArcs([&arcs] (Arc *arc) {
+        arcs.push_back(arc);
+    });
+
+    // undirected edges of all remaining arcs, in the input order
+    auto keep = [input_weights] (const Arc *arc) {
+        return !arc->isLoop() && input_weights->getValue(arc) > 0;
+    };
+    const auto num_chunks = (arcs.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<unsigned long> chunk_begin(num_chunks + 1, 0);
+    parallel_for(num_chunks, threads, [&] (std::size_t c) {
+        const auto end = std::min(arcs.size(), (c + 1) * CHUNK_SIZE);
+        chunk_begin[c + 1] = std::count_if(arcs.begin() + c * CHUNK_SIZE, arcs.begin() + end, keep);
+    });
+    std::partial_sum(chunk_begin.begin(), chunk_begin.end(), chunk_begin.begin());
+    std::vector<edge_triple> triples(chunk_begin.back());
+    parallel_for(num_chunks, threads, [&] (std::size_t c) {
+        const auto end = std::min(arcs.size(), (c + 1) * CHUNK_SIZE);
+        auto out = chunk_begin[c];
+        for (auto i = c * CHUNK_SIZE; i < end; i++) {
+            const auto *arc = arcs[i];
+            if (keep(arc)) {
+                const auto s = arc->getTail()->getId();
+                const auto t = arc->getHead()->getId();
+                triples[out++] = {std::min(s, t), std::max(s, t), input_weights->getValue(arc)};
+            }
+        }
+    });
+    dropped_arcs = arcs.size() - triples.size();
+
+    auto buckets = bucket_edges(n, triples, combine, threads);
+    merged_arcs = triples.size() - buckets.num_edges();
+
+    if (order != INPUT_ORDER) {
+        const auto adj = undirected_adjacency(n, buckets);
+        switch (order) {
+            case DEGREE_ORDER:
+                input_id = by_degree(adj, n, true);
+                break;
+            case RCM_ORDER:
+                input_id = reverse_cuthill_mckee(adj, n);
+                break;
+            default:
+                input_id = community_order(adj, n);
+                break;
+        }
+        relabeled.assign(n, 0);
+        for (auto id = 0UL; id < n; id++) {
+            relabeled[input_id[id]] = id;
+        }
+
+        // same edges, but between the new ids
+        std::vector<unsigned long> out_begin(n + 1, 0);
+        std::partial_sum(buckets.size.begin(), buckets.size.end(), out_begin.begin() + 1);
+        triples.resize(out_begin[n]);
+        const auto vertex_chunk = 1UL << 12;
+        parallel_for((n + vertex_chunk - 1) / vertex_chunk, threads, [&] (std::size_t c) {
+            const auto end = std::min<unsigned long>(n, (c + 1) * vertex_chunk);
+            for (auto u = c * vertex_chunk; u < end; u++) {
+                auto out = out_begin[u];
+                for (auto i = buckets.begin[u]; i < buckets.begin[u] + buckets.size[u]; i++) {
+                    const auto &e = buckets.edges[i];
+                    const auto s = relabeled[u];
+                    const auto t = relabeled[e.other];
+                    triples[out++] = {std::min(s, t), std::max(s, t), e.weight};
+                }
+            }
+        });
+        buckets = bucket_edges(n, triples, combine, threads);
+    }
+
+    // Algora graphs can't be built concurrently
+    std::vector<Vertex*> vertex_of_id(n);
+    for (auto id = 0UL; id < n; id++) {
+        vertex_of_id[id] = graph.addVertex();
+        assert(vertex_of_id[id]->getId() == id);
+    }
+    weights.resetAll(buckets.num_edges());
+    for (auto u = 0UL; u < n; u++) {
+        for (auto i = buckets.begin[u]; i < buckets.begin[u] + buckets.size[u]; i++) {
+            auto *arc = graph.addArc(vertex_of_id[u], vertex_of_id[buckets.edges[i].other]);
+            weights[arc] = buckets.edges[i].weight;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <vector>
+
+#include "graph/digraph.h"
+#include "graph.incidencelist/incidencelistgraph.h"
+#include "property/fastpropertymap.h"
+#include "matching/matching_defs.h"
+
+// Undirected simple copy of a weighted input graph: all arcs between the
+// same two vertices, in either direction, are merged into a single arc
+// whose weight is the sum or the maximum of their weights, and self-loops
+// and arcs of weight 0 are dropped.
+// The copy has a vertex for each vertex id of the input. With the input
+// order, vertex ids stay the same; otherwise, vertices are renumbered to
+// improve the locality of accesses by vertex id:
+//  - DEGREE_ORDER: by decreasing degree,
+//  - RCM_ORDER: reverse Cuthill-McKee, i.e., BFS per component from a
+//    vertex of minimum degree, visiting neighbors by increasing degree,
+//  - COMMUNITY_ORDER: communities found by label propagation are
+//    numbered consecutively, by decreasing degree within a community.
+// Arcs are numbered by their smaller endpoint, then by the larger one,
+// and each arc points from the smaller to the larger id.
+class normalized_graph {
+    public:
+        normalized_graph(NormalizeType combine, VertexOrder order = INPUT_ORDER)
+            : combine(combine), order(order), weights(0) {}
+
+        // may only be called once;
+        // vertex ids of input must be smaller than max_vertex_id
+        void build(Algora::DiGraph *input, Algora::FastPropertyMap<EdgeWeight> *input_weights,
+                Algora::DiGraph::size_type max_vertex_id, unsigned threads);
+
+        Algora::IncidenceListGraph *getDiGraph() {
+            return &graph;
+        }
+
+        Algora::FastPropertyMap<EdgeWeight> *getArcWeights() {
+            return &weights;
+        }
+
+        Algora::DiGraph::size_type getMaxVertexId() const {
+            return graph.getSize();
+        }
+
+        // input vertex id per vertex id, nullptr if the ids are the same
+        const std::vector<unsigned long> *input_ids() const {
+            return order == INPUT_ORDER ? nullptr : &input_id;
+        }
+
+        // vertex id of the vertex with the given id in the input
+        unsigned long relabeled_id(unsigned long id) const {
+            return order == INPUT_ORDER ? id : relabeled[id];
+        }
+
+        // number of input arcs merged into an arc of another one
+        unsigned long num_merged_arcs() const noexcept {
+            return merged_arcs;
+        }
+
+        // number of self-loops and arcs of weight 0 in the input
+        unsigned long num_dropped_arcs() const noexcept {
+            return dropped_arcs;
+        }
+
+    private:
+        NormalizeType combine;
+        VertexOrder order;
+        Algora::IncidenceListGraph graph;
+        Algora::FastPropertyMap<EdgeWeight> weights;
+        std::vector<unsigned long> input_id;
+        std::vector<unsigned long> relabeled;
+        unsigned long merged_arcs{0};
+        unsigned long dropped_arcs{0};
+};
@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "portfolio.h"
+
+#include <condition_variable>
+#include <thread>
+
+#include "tools/chronotimer.h"
+#include "tools/parallel.h"
+
+bool portfolio_solver::solve(unsigned b, std::chrono::milliseconds budget, unsigned num_threads) {
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+
+    std::vector<matching_algorithm*> order;
+    for (auto &algo : baselines) {
+        order.push_back(algo.get());
+    }
+    for (auto &algo : heavies) {
+        order.push_back(algo.get());
+    }
+
+    stop = false;
+    runs.assign(order.size(), run_info());
+    best_index = order.size();
+    best = 0;
+    best_mate.clear();
+    for (auto i = 0UL; i < order.size(); i++) {
+        auto *algo = order[i];
+        runs[i].name = algo->getName();
+        runs[i].short_name = algo->getShortName();
+        algo->set_max_vertex_id(max_vertex_id);
+        algo->setGraph(graph);
+        algo->setWeights(weights);
+        algo->set_stop_flag(&stop);
+    }
+
+    // watchdog: raise the stop flag at the deadline
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    bool done = false;
+    std::thread watchdog([&] () {
+        std::unique_lock<std::mutex> lock(done_mutex);
+        done_cv.wait_until(lock, deadline, [&done] { return done; });
+        stop = true;
+    });
+
+    // tasks are handed out in order, so baselines start first
+    parallel_for(order.size(), num_threads, [&] (size_t i) {
+        if (stop) {
+            return;
+        }
+        run_one(*order[i], b, runs[i], i);
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(done_mutex);
+        done = true;
+    }
+    done_cv.notify_one();
+    watchdog.join();
+
+    for (auto *algo : order) {
+        algo->set_stop_flag(nullptr);
+    }
+    return has_solution();
+}
+
+void portfolio_solver::run_one(matching_algorithm &algo, unsigned b, run_info &info, size_t index) {
+    info.started = true;
+    algo.set_num_matchings(b);
+    if (!algo.prepare()) {
+        return;
+    }
+    ChronoTimer t;
+    algo.run();
+    info.time = t.elapsed<>();
+    info.finished = !algo.was_interrupted();
+    info.weight = algo.deliver();
+    if (!info.finished) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(best_mutex);
+    if (!has_solution() || info.weight > best) {
+        best = info.weight;
+        best_index = index;
+        best_edge_color = algo.getEdgeColors();
+        best_mate = algo.getMates();
+    }
+}
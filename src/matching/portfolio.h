@@ -0,0 +1,96 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "matching_algorithm.h"
+
+// Anytime portfolio: runs several algorithms concurrently on the same
+// (read-only) graph and keeps the heaviest solution found until a
+// wall-clock deadline. Baselines are started first, heavier variants
+// as soon as threads become available. At the deadline, all running
+// algorithms are stopped via their cancellation points; only solutions
+// of algorithms that completed are taken into account.
+class portfolio_solver {
+    public:
+        using color_t = matching_algorithm::color_t;
+
+        struct run_info {
+            std::string name;
+            std::string short_name;
+            bool started{false};
+            bool finished{false};
+            EdgeWeight weight{0};
+            double time{0.0};
+        };
+
+        portfolio_solver(Algora::DiGraph *graph, Algora::FastPropertyMap<EdgeWeight> *weights,
+                const Algora::DiGraph::size_type &max_vertex_id)
+            : graph(graph), weights(weights), max_vertex_id(max_vertex_id) {}
+
+        void add_baseline(matching_algorithm *algo) {
+            baselines.emplace_back(algo);
+        }
+
+        void add_heavy(matching_algorithm *algo) {
+            heavies.emplace_back(algo);
+        }
+
+        // runs the portfolio for b matchings on up to num_threads threads
+        // (0: one per core); returns whether any algorithm completed
+        bool solve(unsigned b, std::chrono::milliseconds budget, unsigned num_threads);
+
+        bool has_solution() const noexcept {
+            return best_index < runs.size();
+        }
+
+        EdgeWeight best_weight() const noexcept {
+            return best;
+        }
+
+        const run_info &best_run() const {
+            return runs.at(best_index);
+        }
+
+        // copy of the coloring and the mates of the best solution,
+        // taken when its algorithm finished
+        const Algora::FastPropertyMap<color_t> &best_edge_colors() const noexcept {
+            return best_edge_color;
+        }
+
+        const std::vector<Algora::FastPropertyMap<Algora::Vertex*>> &best_mates() const noexcept {
+            return best_mate;
+        }
+
+        // in the order baselines, then heavy variants, each in the order added
+        const std::vector<run_info> &get_runs() const noexcept {
+            return runs;
+        }
+
+    private:
+        Algora::DiGraph *graph;
+        Algora::FastPropertyMap<EdgeWeight> *weights;
+        Algora::DiGraph::size_type max_vertex_id;
+
+        std::vector<std::unique_ptr<matching_algorithm>> baselines;
+        std::vector<std::unique_ptr<matching_algorithm>> heavies;
+
+        std::atomic<bool> stop{false};
+        std::mutex best_mutex;
+        std::vector<run_info> runs;
+        size_t best_index{0};
+        EdgeWeight best{0};
+        Algora::FastPropertyMap<color_t> best_edge_color;
+        std::vector<Algora::FastPropertyMap<Algora::Vertex*>> best_mate;
+
+        void run_one(matching_algorithm &algo, unsigned b, run_info &info, size_t index);
+};
@@ -0,0 +1,104 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DJM_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define DJM_PREFETCH(addr) ((void) (addr))
+#endif
+
+#ifndef DJM_PREFETCH_WINDOW
+#define DJM_PREFETCH_WINDOW 16
+#endif
+
+// Scans a vector of arcs in order and commits a decision for each arc,
+// just like a plain for loop would do.
+// To hide memory latency, the scan works on windows of arcs and runs
+// a software pipeline three windows deep:
+//  - the arc objects three windows ahead are prefetched,
+//  - the endpoints of the arcs two windows ahead are resolved via
+//    resolve(arc), which should also prefetch the vertex objects,
+//  - prefetch(arc, endpoints) is called on the arcs of the next window
+//    to prefetch the vertex state, e.g. mate entries,
+//  - commit(arc, endpoints) is called on the arcs of the current window,
+//    in the original order.
+// As all decisions are taken in commit, the result is identical to the
+// one of a plain scan, as long as resolve and prefetch have no side
+// effects on the state read by commit.
+// With a window size of 0, this is just a plain scan.
+template <std::size_t window = DJM_PREFETCH_WINDOW,
+         typename ArcPtr, typename Resolve, typename Prefetch, typename Commit>
+inline void prefetched_scan(const std::vector<ArcPtr> &arcs,
+        Resolve &&resolve, Prefetch &&prefetch, Commit &&commit) {
+    if constexpr (window == 0) {
+        for (const auto &arc : arcs) {
+            commit(arc, resolve(arc));
+        }
+        return;
+    } else {
+
+    using Endpoints = decltype(resolve(arcs.front()));
+    constexpr std::size_t depth = 3;
+    Endpoints buffer[depth][window];
+
+    const auto size = arcs.size();
+    if (size == 0) {
+        return;
+    }
+
+    auto window_end = [size](std::size_t begin) {
+        return std::min(size, begin + window);
+    };
+    auto prefetch_arcs = [&arcs,&window_end](std::size_t begin) {
+        for (auto i = begin; i < window_end(begin); i++) {
+            DJM_PREFETCH(arcs[i]);
+        }
+    };
+    auto resolve_window = [&](std::size_t begin, Endpoints *ends) {
+        for (auto i = begin; i < window_end(begin); i++) {
+            ends[i - begin] = resolve(arcs[i]);
+        }
+    };
+    auto prefetch_window = [&](std::size_t begin, Endpoints *ends) {
+        for (auto i = begin; i < window_end(begin); i++) {
+            prefetch(arcs[i], ends[i - begin]);
+        }
+    };
+
+    // fill the pipeline
+    prefetch_arcs(0);
+    prefetch_arcs(window);
+    prefetch_arcs(2 * window);
+    resolve_window(0, buffer[0]);
+    if (window < size) {
+        resolve_window(window, buffer[1]);
+    }
+    prefetch_window(0, buffer[0]);
+
+    for (std::size_t begin = 0, w = 0; begin < size; begin += window, w++) {
+        if (begin + 3 * window < size) {
+            prefetch_arcs(begin + 3 * window);
+        }
+        if (begin + 2 * window < size) {
+            resolve_window(begin + 2 * window, buffer[(w + 2) % depth]);
+        }
+        if (begin + window < size) {
+            prefetch_window(begin + window, buffer[(w + 1) % depth]);
+        }
+
+        auto *ends = buffer[w % depth];
+        for (auto i = begin; i < window_end(begin); i++) {
+            commit(arcs[i], ends[i - begin]);
+        }
+    }
+
+    }
+}
@@ -0,0 +1,33 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "matching/solution_io.h"
+
+#include <sstream>
+
+bool read_solution(std::istream &in, std::vector<solution_link> &links, std::string &error) {
+    std::string line;
+    unsigned long line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        if (line.compare(0, 8, "% window") == 0) {
+            error = "line " + std::to_string(line_no) + " starts a window of --window-output, "
+                "which gives input labels instead of vertex ids";
+            return false;
+        }
+        if (line.empty() || line[0] == '%') {
+            continue;
+        }
+        std::istringstream fields(line);
+        solution_link link;
+        if (!(fields >> link.tail >> link.head >> link.color)) {
+            error = "expected \"tail head color\" in line " + std::to_string(line_no);
+            return false;
+        }
+        links.push_back(link);
+    }
+    return true;
+}
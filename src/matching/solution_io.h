@@ -0,0 +1,28 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <istream>
+#include <string>
+#include <vector>
+
+// one matched arc of a solution, given by the vertex ids of its
+// endpoints and the index of its matching
+// Solution files use the vertex ids of the graph read from the input,
+// as written by --solution-output and --stream-matchings. The window mode
+// numbers its vertices itself and writes input labels instead, so its
+// files are not solutions in this sense.
+struct solution_link {
+    unsigned long long tail;
+    unsigned long long head;
+    unsigned color;
+};
+
+// reads a solution in text format, one link "tail head color" per line;
+// lines starting with '%' are comments
+// returns false and sets error on malformed input or on the output of
+// --window-output, which is recognized by its "% window" lines
+bool read_solution(std::istream &in, std::vector<solution_link> &links, std::string &error);
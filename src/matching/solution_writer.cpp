@@ -0,0 +1,245 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "matching/solution_writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+#include "tools/parallel.h"
+
+namespace {
+
+constexpr std::uint32_t UNMATCHED_ID = std::numeric_limits<std::uint32_t>::max();
+constexpr std::uint32_t BINARY_VERSION = 1;
+constexpr std::size_t BINARY_HEADER_SIZE = 16;
+
+// output file of a known size, either mapped into memory or written to
+// with positional writes, both of which are safe from several threads
+class output_file {
+    public:
+        ~output_file() {
+            close();
+        }
+
+        bool open(const std::string &filename, std::size_t size, bool use_mmap, std::string &error) {
+            fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                error = "could not open " + filename + ": " + std::strerror(errno);
+                return false;
+            }
+            if (!use_mmap || size == 0) {
+                return true;
+            }
+            if (::ftruncate(fd, size) != 0) {
+                error = "could not resize " + filename + ": " + std::strerror(errno);
+                return false;
+            }
+            auto addr = ::mmap(nullptr, size, PROT_WRITE, MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) {
+                error = "could not map " + filename + ": " + std::strerror(errno);
+                return false;
+            }
+            mapped = static_cast<char*>(addr);
+            mapped_size = size;
+            return true;
+        }
+
+        bool write(const void *data, std::size_t size, std::size_t offset) {
+            if (mapped != nullptr) {
+                std::memcpy(mapped + offset, data, size);
+                return true;
+            }
+            auto bytes = static_cast<const char*>(data);
+            while (size > 0) {
+                auto written = ::pwrite(fd, bytes, size, offset);
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return false;
+                }
+                bytes += written;
+                offset += written;
+                size -= written;
+            }
+            return true;
+        }
+
+        bool close() {
+            auto ok = true;
+            if (mapped != nullptr) {
+                ok = ::munmap(mapped, mapped_size) == 0;
+                mapped = nullptr;
+            }
+            if (fd >= 0) {
+                ok = ::close(fd) == 0 && ok;
+                fd = -1;
+            }
+            return ok;
+        }
+
+    private:
+        int fd{-1};
+        char *mapped{nullptr};
+        std::size_t mapped_size{0};
+};
+
+void append_number(std::string &out, unsigned long long value) {
+    char digits[24];
+    auto res = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, res.ptr);
+}
+
+// read access to the matchings of an algorithm or of a copy of them
+class solution_view {
+    public:
+        using color_t = matching_algorithm::color_t;
+
+        solution_view(const matching_algorithm &algo) : algo(&algo) {}
+        solution_view(const Algora::FastPropertyMap<color_t> &edge_color,
+                const std::vector<Algora::FastPropertyMap<Algora::Vertex*>> &mate)
+            : edge_color(&edge_color), mate(&mate) {}
+
+        // color of arc, UNMATCHED if not matched
+        color_t color(const Algora::Arc *arc) const {
+            if (algo != nullptr) {
+                return algo->isMatched(arc) ? algo->getEdgeColor(arc) : UNMATCHED;
+            }
+            return (*edge_color)(arc);
+        }
+
+        Algora::Vertex *get_mate(color_t c, const Algora::Vertex *v) const {
+            return algo != nullptr ? algo->getMate(c, v) : (*mate)[c](v);
+        }
+
+        static constexpr color_t UNMATCHED = std::numeric_limits<color_t>::max();
+
+    private:
+        const matching_algorithm *algo{nullptr};
+        const Algora::FastPropertyMap<color_t> *edge_color{nullptr};
+        const std::vector<Algora::FastPropertyMap<Algora::Vertex*>> *mate{nullptr};
+};
+
+unsigned long output_id(const solution_writer_options &options, const Algora::Vertex *v) {
+    return options.vertex_ids ? (*options.vertex_ids)[v->getId()] : v->getId();
+}
+
+bool write_text(const std::string &filename, Algora::DiGraph *graph,
+        const solution_view &solution, unsigned num_matchings,
+        const solution_writer_options &options, std::string &error) {
+    using namespace Algora;
+    std::vector<std::vector<Arc*>> arcs_by_color(num_matchings);
+    graph->mapArcs([&solution,&arcs_by_color] (Arc *arc) {
+        const auto c = solution.color(arc);
+        if (c < arcs_by_color.size()) {
+            arcs_by_color[c].push_back(arc);
+        }
+    });
+
+    std::vector<std::string> lines(num_matchings);
+    parallel_for(num_matchings, options.threads, [&] (std::size_t c) {
+        auto &out = lines[c];
+        out.reserve(arcs_by_color[c].size() * 24);
+        for (const auto *arc : arcs_by_color[c]) {
+            append_number(out, output_id(options, arc->getTail()));
+            out.push_back(' ');
+            append_number(out, output_id(options, arc->getHead()));
+            out.push_back(' ');
+            append_number(out, c);
+            out.push_back('\n');
+        }
+    });
+
+    std::vector<std::size_t> offsets(num_matchings + 1, 0);
+    for (auto c = 0U; c < num_matchings; c++) {
+        offsets[c + 1] = offsets[c] + lines[c].size();
+    }
+    output_file file;
+    if (!file.open(filename, offsets.back(), options.use_mmap, error)) {
+        return false;
+    }
+    std::vector<char> ok(num_matchings, true);
+    parallel_for(num_matchings, options.threads, [&] (std::size_t c) {
+        ok[c] = file.write(lines[c].data(), lines[c].size(), offsets[c]);
+    });
+    if (!file.close() || std::find(ok.begin(), ok.end(), false) != ok.end()) {
+        error = "could not write " + filename;
+        return false;
+    }
+    return true;
+}
+
+bool write_binary(const std::string &filename, Algora::DiGraph *graph,
+        const solution_view &solution, unsigned num_matchings,
+        const solution_writer_options &options, std::string &error) {
+    using namespace Algora;
+    std::uint32_t n = 0;
+    graph->mapVertices([&n,&options] (Vertex *v) {
+        n = std::max<std::uint32_t>(n, output_id(options, v) + 1);
+    });
+
+    const auto column_size = static_cast<std::size_t>(n) * sizeof(std::uint32_t);
+    output_file file;
+    if (!file.open(filename, BINARY_HEADER_SIZE + num_matchings * column_size, options.use_mmap, error)) {
+        return false;
+    }
+
+    char header[BINARY_HEADER_SIZE];
+    std::memcpy(header, "DJMS", 4);
+    const std::uint32_t fields[] = { BINARY_VERSION, n, num_matchings };
+    std::memcpy(header + 4, fields, sizeof(fields));
+    auto header_ok = file.write(header, sizeof(header), 0);
+
+    std::vector<char> ok(num_matchings, true);
+    parallel_for(num_matchings, options.threads, [&] (std::size_t c) {
+        std::vector<std::uint32_t> column(n, UNMATCHED_ID);
+        graph->mapVertices([&solution,&column,&options,c] (Vertex *v) {
+            auto m = solution.get_mate(c, v);
+            if (m != nullptr) {
+                column[output_id(options, v)] = output_id(options, m);
+            }
+        });
+        ok[c] = file.write(column.data(), column_size, BINARY_HEADER_SIZE + c * column_size);
+    });
+    if (!file.close() || !header_ok || std::find(ok.begin(), ok.end(), false) != ok.end()) {
+        error = "could not write " + filename;
+        return false;
+    }
+    return true;
+}
+
+bool write_view(const std::string &filename, Algora::DiGraph *graph,
+        const solution_view &solution, unsigned num_matchings,
+        const solution_writer_options &options, std::string &error) {
+    if (options.format == solution_format::BINARY) {
+        return write_binary(filename, graph, solution, num_matchings, options, error);
+    }
+    return write_text(filename, graph, solution, num_matchings, options, error);
+}
+
+}
+
+bool write_solution(const std::string &filename, Algora::DiGraph *graph,
+        const matching_algorithm &algo, unsigned num_matchings,
+        const solution_writer_options &options, std::string &error) {
+    return write_view(filename, graph, solution_view(algo), num_matchings, options, error);
+}
+
+bool write_solution(const std::string &filename, Algora::DiGraph *graph,
+        const Algora::FastPropertyMap<matching_algorithm::color_t> &edge_color,
+        const std::vector<Algora::FastPropertyMap<Algora::Vertex*>> &mate,
+        unsigned num_matchings, const solution_writer_options &options, std::string &error) {
+    return write_view(filename, graph, solution_view(edge_color, mate), num_matchings, options, error);
+}
@@ -0,0 +1,54 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+
+#include "matching/matching_algorithm.h"
+
+enum class solution_format { TEXT, BINARY };
+
+struct solution_writer_options {
+    solution_format format{solution_format::TEXT};
+    // map the output file into memory instead of writing through a stream
+    bool use_mmap{false};
+    // threads for formatting / writing matchings in parallel, 0 = one per core
+    unsigned threads{0};
+    // id to write per vertex id, nullptr = the vertex ids themselves
+    const std::vector<unsigned long> *vertex_ids{nullptr};
+};
+
+// Writes the first num_matchings matchings of the current solution of algo
+// on graph to filename. Vertices are given by their ids in graph, or by
+// options.vertex_ids if set, which must map them back to the ids of the
+// graph read from the input, so that the file can be used as a warm start.
+//
+// Text format: one line "tail head color" per matched arc, ordered by
+// color; it can be read by read_solution().
+//
+// Binary format, columnar, in host byte order:
+//   char[4]  magic "DJMS"
+//   uint32   version (1)
+//   uint32   n, number of vertex ids (maximum id + 1)
+//   uint32   k, number of matchings
+//   k times uint32[n]: mate id of each vertex in that matching,
+//                      0xFFFFFFFF if unmatched
+//
+// Each matching is formatted by its own task, so large solutions are
+// written in parallel per color.
+// Returns false and sets error if the file could not be written.
+bool write_solution(const std::string &filename, Algora::DiGraph *graph,
+        const matching_algorithm &algo, unsigned num_matchings,
+        const solution_writer_options &options, std::string &error);
+
+// same for a copy of a solution, e.g., kept by the portfolio, given by the
+// color of each arc (num_matchings or more if unmatched) and the mates of
+// each vertex per matching
+bool write_solution(const std::string &filename, Algora::DiGraph *graph,
+        const Algora::FastPropertyMap<matching_algorithm::color_t> &edge_color,
+        const std::vector<Algora::FastPropertyMap<Algora::Vertex*>> &mate,
+        unsigned num_matchings, const solution_writer_options &options, std::string &error);
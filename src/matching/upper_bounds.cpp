@@ -0,0 +1,144 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "matching/upper_bounds.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "tools/parallel.h"
+
+namespace {
+
+const auto VERTEX_CHUNK = 1UL << 12;
+
+// sum of fn(v) over all v < n, in chunks on up to threads threads
+template<typename T, typename F>
+T parallel_sum(unsigned long n, unsigned threads, F &&fn) {
+    const auto num_chunks = (n + VERTEX_CHUNK - 1) / VERTEX_CHUNK;
+    std::vector<T> chunk_sum(num_chunks, 0);
+    parallel_for(num_chunks, threads, [n,&fn,&chunk_sum] (std::size_t c) {
+        const auto end = std::min(n, (c + 1) * VERTEX_CHUNK);
+        T sum = 0;
+        for (auto v = c * VERTEX_CHUNK; v < end; v++) {
+            sum += fn(v);
+        }
+        chunk_sum[c] = sum;
+    });
+    T sum = 0;
+    for (auto s : chunk_sum) {
+        sum += s;
+    }
+    return sum;
+}
+
+}
+
+upper_bounds::upper_bounds(Algora::DiGraph *graph, const Algora::FastPropertyMap<EdgeWeight> &weights,
+        Algora::DiGraph::size_type max_vertex_id, unsigned threads) : threads(threads) {
+    using namespace Algora;
+    const auto n = static_cast<unsigned long>(max_vertex_id);
+    begin.assign(n + 1, 0);
+    graph->mapArcs([this,&weights] (Arc *a) {
+        if (a->getTail() == a->getHead()) {
+            loop_weight += weights(a);
+            return;
+        }
+        begin[a->getTail()->getId() + 1]++;
+        begin[a->getHead()->getId() + 1]++;
+    });
+    for (auto v = 0UL; v < n; v++) {
+        begin[v + 1] += begin[v];
+    }
+    incident.resize(begin[n]);
+    std::vector<unsigned long> next(begin.begin(), begin.end() - 1);
+    graph->mapArcs([this,&weights,&next] (Arc *a) {
+        const auto u = a->getTail()->getId();
+        const auto v = a->getHead()->getId();
+        if (u == v) {
+            return;
+        }
+        incident[next[u]++] = {weights(a), v};
+        incident[next[v]++] = {weights(a), u};
+    });
+
+    parallel_for((n + VERTEX_CHUNK - 1) / VERTEX_CHUNK, threads, [this,n] (std::size_t c) {
+        const auto end = std::min(n, (c + 1) * VERTEX_CHUNK);
+        for (auto v = c * VERTEX_CHUNK; v < end; v++) {
+            std::sort(incident.begin() + begin[v], incident.begin() + begin[v + 1],
+                    [] (const incident_arc &lop, const incident_arc &rop) {
+                return lop.weight > rop.weight;
+            });
+        }
+    });
+}
+
+EdgeWeight upper_bounds::top_b(unsigned b) const {
+    const auto sum = parallel_sum<EdgeWeight>(begin.size() - 1, threads, [this,b] (unsigned long v) {
+        EdgeWeight s = 0;
+        const auto last = std::min(begin[v + 1], begin[v] + b);
+        for (auto i = begin[v]; i < last; i++) {
+            s += incident[i].weight;
+        }
+        return s;
+    });
+    // the optimum is integral, so rounding down keeps the bound
+    return sum / 2 + loop_weight;
+}
+
+long long upper_bounds::dual_objective(unsigned b, long long scale, const std::vector<long long> &y) const {
+    // every arc is counted at its endpoint with the smaller id
+    return parallel_sum<long long>(begin.size() - 1, threads, [this,b,scale,&y] (unsigned long v) {
+        long long s = static_cast<long long>(b) * y[v];
+        for (auto i = begin[v]; i < begin[v + 1]; i++) {
+            const auto &arc = incident[i];
+            if (v < arc.other) {
+                s += std::max(0LL, static_cast<long long>(arc.weight) * scale - y[v] - y[arc.other]);
+            }
+        }
+        return s;
+    }) + static_cast<long long>(loop_weight) * scale;
+}
+
+EdgeWeight upper_bounds::fractional(unsigned b, unsigned rounds) const {
+    const auto n = begin.size() - 1;
+    // potentials are halved once initially and once per round
+    const long long scale = 1LL << (rounds + 1);
+    std::vector<long long> y(n, 0);
+    for (auto v = 0UL; v < n; v++) {
+        if (begin[v + 1] - begin[v] > b) {
+            y[v] = static_cast<long long>(incident[begin[v] + b].weight) * (scale / 2);
+        }
+    }
+    auto best = dual_objective(b, scale, y);
+
+    std::vector<long long> response(n, 0);
+    const auto num_chunks = (n + VERTEX_CHUNK - 1) / VERTEX_CHUNK;
+    for (auto r = 0U; r < rounds; r++) {
+        parallel_for(num_chunks, threads, [&] (std::size_t c) {
+            std::vector<long long> residual;
+            const auto end = std::min(n, (c + 1) * VERTEX_CHUNK);
+            for (auto v = c * VERTEX_CHUNK; v < end; v++) {
+                if (begin[v + 1] - begin[v] <= b) {
+                    response[v] = 0;
+                    continue;
+                }
+                residual.clear();
+                for (auto i = begin[v]; i < begin[v + 1]; i++) {
+                    residual.push_back(static_cast<long long>(incident[i].weight) * scale - y[incident[i].other]);
+                }
+                std::nth_element(residual.begin(), residual.begin() + b, residual.end(), std::greater<long long>());
+                response[v] = std::max(0LL, residual[b]);
+            }
+        });
+        for (auto v = 0UL; v < n; v++) {
+            y[v] = (y[v] + response[v]) / 2;
+        }
+        best = std::min(best, dual_objective(b, scale, y));
+    }
+    const auto bound = static_cast<EdgeWeight>((best + scale - 1) / scale);
+    return std::min(bound, top_b(b));
+}
@@ -0,0 +1,56 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+#include <vector>
+
+#include "graph/digraph.h"
+#include "property/fastpropertymap.h"
+#include "matching/matching_defs.h"
+
+// Upper bounds on the weight of a maximum weight b-matching, i.e., of
+// b disjoint matchings, to tell how far an algorithm is from the optimum.
+// The incident weights of each vertex are gathered once, so that bounds
+// for several b are cheap. Self-loops only add their weight.
+class upper_bounds {
+    public:
+        // vertex ids of graph must be smaller than max_vertex_id
+        upper_bounds(Algora::DiGraph *graph, const Algora::FastPropertyMap<EdgeWeight> &weights,
+                Algora::DiGraph::size_type max_vertex_id, unsigned threads);
+
+        // half the sum over all vertices of their b heaviest incident
+        // weights, as every matched arc is counted at both endpoints
+        EdgeWeight top_b(unsigned b) const;
+
+        // objective of a feasible dual solution of the fractional
+        // b-matching LP: for vertex potentials y >= 0, every arc uv that
+        // is heavier than y_u + y_v adds the difference, and every vertex
+        // adds b * y_v.
+        // Starts from y_v = half the (b+1)-th heaviest incident weight,
+        // which is at most top_b(b), and improves y by rounds of parallel
+        // damped best responses, i.e., y_v is averaged with the (b+1)-th
+        // largest residual weight w_uv - y_u of its arcs.
+        // Each round takes linear time; potentials are kept exactly as
+        // multiples of 2^-(rounds + 1).
+        EdgeWeight fractional(unsigned b, unsigned rounds = 3) const;
+
+    private:
+        struct incident_arc {
+            EdgeWeight weight;
+            unsigned long other;
+        };
+
+        unsigned threads;
+        // incident arcs of vertex id v, heaviest first, are
+        // incident[begin[v]], ..., incident[begin[v + 1] - 1]
+        std::vector<unsigned long> begin;
+        std::vector<incident_arc> incident;
+        // total weight of all self-loops
+        EdgeWeight loop_weight{0};
+
+        // dual objective for the potentials y, scaled like y
+        long long dual_objective(unsigned b, long long scale, const std::vector<long long> &y) const;
+};
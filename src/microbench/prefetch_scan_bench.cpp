@@ -0,0 +1,180 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+// Microbenchmark for the prefetched greedy scan kernel.
+// Mimics the memory layout of the GreedyIt round scan on an Algora graph:
+// vertices and arcs are individually allocated objects that are scattered
+// over the heap, arcs are visited in (random) weight order, and the
+// vertex state (mates) is indexed by vertex id.
+// Runs one full GreedyIt pass (k rounds) with a plain and with the
+// prefetched scan and checks that both produce identical matchings.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "tools/chronotimer.h"
+#include "matching/prefetch_scan.h"
+
+struct BenchVertex {
+    unsigned id;
+    // Algora vertices carry more than just their id
+    char payload[60];
+};
+
+struct BenchArc {
+    BenchVertex *tail;
+    BenchVertex *head;
+    unsigned id;
+    char payload[44];
+};
+
+using endpoints_t = std::pair<BenchVertex*, BenchVertex*>;
+constexpr unsigned UNCOLORED = ~0U;
+
+struct Instance {
+    std::vector<std::unique_ptr<BenchVertex>> vertices;
+    std::vector<std::unique_ptr<BenchArc>> arcs;
+    std::vector<BenchArc*> sorted;
+};
+
+Instance generate(unsigned log_n, unsigned avg_degree, std::mt19937 &rng) {
+    Instance inst;
+    const unsigned n = 1U << log_n;
+    const unsigned long m = static_cast<unsigned long>(n) * avg_degree / 2;
+
+    // allocate in random order to scatter objects over the heap
+    std::vector<unsigned> ids(n);
+    for (auto i = 0U; i < n; i++) {
+        ids[i] = i;
+    }
+    std::shuffle(ids.begin(), ids.end(), rng);
+    inst.vertices.resize(n);
+    for (auto id : ids) {
+        inst.vertices[id].reset(new BenchVertex{id, {}});
+    }
+
+    std::uniform_int_distribution<unsigned> vdist(0, n - 1);
+    inst.arcs.reserve(m);
+    for (auto i = 0UL; i < m; i++) {
+        auto u = vdist(rng);
+        auto v = vdist(rng);
+        while (u == v) {
+            v = vdist(rng);
+        }
+        inst.arcs.emplace_back(new BenchArc{inst.vertices[u].get(), inst.vertices[v].get(),
+                static_cast<unsigned>(i), {}});
+    }
+
+    // weight order is unrelated to allocation order
+    inst.sorted.reserve(m);
+    for (auto &a : inst.arcs) {
+        inst.sorted.push_back(a.get());
+    }
+    std::shuffle(inst.sorted.begin(), inst.sorted.end(), rng);
+    return inst;
+}
+
+template <bool prefetch>
+unsigned long greedy_rounds(const Instance &inst, unsigned k,
+        std::vector<unsigned> &edge_color) {
+    const auto n = inst.vertices.size();
+    std::vector<std::vector<BenchVertex*>> mate(k, std::vector<BenchVertex*>(n, nullptr));
+    edge_color.assign(inst.arcs.size(), UNCOLORED);
+
+    std::vector<BenchArc*> edges(inst.sorted);
+    std::vector<BenchArc*> remaining;
+    remaining.reserve(edges.size());
+    unsigned long matched = 0;
+
+    for (auto bi = 0U; bi < k; bi++) {
+        auto &m = mate[bi];
+        auto commit = [&](BenchArc *arc, const endpoints_t &ends) {
+            if (edge_color[arc->id] != UNCOLORED) {
+                return;
+            }
+            if (m[ends.first->id] != nullptr || m[ends.second->id] != nullptr) {
+                remaining.push_back(arc);
+            } else {
+                m[ends.first->id] = ends.second;
+                m[ends.second->id] = ends.first;
+                edge_color[arc->id] = bi;
+                matched++;
+            }
+        };
+        if (prefetch) {
+            prefetched_scan(edges, [](const BenchArc *arc) {
+                DJM_PREFETCH(arc->tail);
+                DJM_PREFETCH(arc->head);
+                return endpoints_t(arc->tail, arc->head);
+            }, [&](const BenchArc *arc, const endpoints_t &ends) {
+                DJM_PREFETCH(&edge_color[arc->id]);
+                DJM_PREFETCH(&m[ends.first->id]);
+                DJM_PREFETCH(&m[ends.second->id]);
+            }, commit);
+        } else {
+            for (auto *arc : edges) {
+                commit(arc, endpoints_t(arc->tail, arc->head));
+            }
+        }
+        std::swap(edges, remaining);
+        remaining.clear();
+    }
+    return matched;
+}
+
+int main(int argc, char **argv) {
+    unsigned min_log_n = argc > 1 ? std::atoi(argv[1]) : 16;
+    unsigned max_log_n = argc > 2 ? std::atoi(argv[2]) : 22;
+    unsigned avg_degree = argc > 3 ? std::atoi(argv[3]) : 16;
+    unsigned k = argc > 4 ? std::atoi(argv[4]) : 8;
+    unsigned reps = argc > 5 ? std::atoi(argv[5]) : 3;
+
+    if (argc > 6 || min_log_n == 0 || max_log_n < min_log_n || avg_degree == 0 || k == 0 || reps == 0) {
+        std::cerr << "Usage: " << argv[0] << " [min_log_n] [max_log_n] [avg_degree] [k] [repetitions]\n";
+        return 1;
+    }
+
+    std::cout << "| " << std::setw(6) << "log n" << " | " << std::setw(12) << "arcs"
+        << " | " << std::setw(12) << "plain (s)" << " | " << std::setw(12) << "prefetch (s)"
+        << " | " << std::setw(8) << "speedup" << " |\n";
+
+    std::mt19937 rng(42);
+    for (auto log_n = min_log_n; log_n <= max_log_n; log_n++) {
+        auto inst = generate(log_n, avg_degree, rng);
+        std::vector<unsigned> colors_plain, colors_prefetch;
+        double best_plain = 0.0, best_prefetch = 0.0;
+        ChronoTimer t;
+        for (auto r = 0U; r < reps; r++) {
+            t.restart();
+            auto m_plain = greedy_rounds<false>(inst, k, colors_plain);
+            auto time_plain = t.elapsed();
+            t.restart();
+            auto m_prefetch = greedy_rounds<true>(inst, k, colors_prefetch);
+            auto time_prefetch = t.elapsed();
+
+            if (m_plain != m_prefetch || colors_plain != colors_prefetch) {
+                std::cerr << "Error: prefetched scan differs from plain scan for log n = " << log_n << "\n";
+                return 1;
+            }
+            if (r == 0 || time_plain < best_plain) {
+                best_plain = time_plain;
+            }
+            if (r == 0 || time_prefetch < best_prefetch) {
+                best_prefetch = time_prefetch;
+            }
+        }
+        std::cout << "| " << std::setw(6) << log_n << " | " << std::setw(12) << inst.arcs.size()
+            << " | " << std::setw(12) << std::fixed << std::setprecision(6) << best_plain
+            << " | " << std::setw(12) << best_prefetch
+            << " | " << std::setw(8) << std::setprecision(2) << best_plain / best_prefetch << " |\n";
+    }
+    return 0;
+}
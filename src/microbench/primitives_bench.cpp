@@ -0,0 +1,340 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+// Microbenchmark for the inner primitives of the matching algorithms.
+// For each generated instance type (skewed R-MAT, uniform Erdős–Rényi,
+// Barabási–Albert, datacenter) and each k, k-Edge Coloring is run once,
+// and the primitives are timed on the state it leaves behind, i.e., with
+// the free colors, fans and cd-paths of a real run:
+//  - matching_free_color and set_edge_color / unset_edge_color,
+//  - kEdgeColoring::quicker_fan for the arcs left uncolored,
+//  - kEdgeColoring::invert_cd_path_it, each path is inverted and restored,
+//  - path_set::add_if_applicable for all arcs, heaviest first, as in GPA,
+//  - node_centered::first_free_matching_color on the free colors per vertex,
+//  - FastPropertyMap access to edge colors and mates versus a raw vector.
+// Arcs are visited in weight order, as by the algorithms. Each primitive
+// reports the best time over all repetitions and the mean of its result,
+// e.g., the fan size or the path length.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tools/chronotimer.h"
+#include "bench/generators.h"
+#include "matching/coloring/k_edge_coloring.hpp"
+#include "matching/node_centered.h"
+#include "matching/gpa/path_set.h"
+
+using color_t = matching_algorithm::color_t;
+
+// makes the primitives of k-Edge Coloring accessible to time them
+class kEdgeColoring_primitives : public kEdgeColoring {
+public:
+    using kEdgeColoring::kEdgeColoring;
+    using kEdgeColoring::UNCOLORED;
+    using kEdgeColoring::edge_color;
+    using kEdgeColoring::mate;
+    using kEdgeColoring::arcToMate;
+    using kEdgeColoring::matching_free_color;
+    using kEdgeColoring::set_edge_color;
+    using kEdgeColoring::unset_edge_color;
+    using kEdgeColoring::quicker_fan;
+    using kEdgeColoring::find_free_color;
+    using kEdgeColoring::invert_cd_path_it;
+};
+
+struct primitive_bench {
+    MatchingConfig config;
+    Algora::IncidenceListGraph graph;
+    Algora::FastPropertyMap<EdgeWeight> weights{0};
+    // heaviest first
+    std::vector<Arc*> arcs;
+    kEdgeColoring_primitives kec{config};
+    unsigned repetitions{1};
+    std::string instance;
+    unsigned k{1};
+
+    primitive_bench(const instance_params &params, unsigned repetitions)
+        : repetitions(repetitions), instance(instance_name(params)) {
+        const auto generated = generate_instance(params, 1);
+        std::vector<Vertex*> vertex_of_id(1UL << params.log_n);
+        for (auto &v : vertex_of_id) {
+            v = graph.addVertex();
+        }
+        weights.resetAll(generated.size());
+        for (const auto &arc : generated) {
+            auto *a = graph.addArc(vertex_of_id[arc.tail], vertex_of_id[arc.head]);
+            weights[a] = arc.weight;
+            arcs.push_back(a);
+        }
+        std::stable_sort(arcs.begin(), arcs.end(), [this] (const Arc *lop, const Arc *rop) {
+            return weights(lop) > weights(rop);
+        });
+    }
+
+    // colors the instance with k colors, the state all primitives run on
+    bool color(unsigned num_colors) {
+        k = num_colors;
+        kec.set_max_vertex_id(graph.getSize());
+        kec.setGraph(&graph);
+        kec.setWeights(&weights);
+        kec.set_num_matchings(k);
+        if (!kec.prepare()) {
+            return false;
+        }
+        kec.run();
+        return true;
+    }
+
+    void print_header() const {
+        std::cout << "| " << std::left << std::setw(24) << "instance" << std::right
+            << " | " << std::setw(4) << "k"
+            << " | " << std::left << std::setw(28) << "primitive" << std::right
+            << " | " << std::setw(10) << "ops"
+            << " | " << std::setw(10) << "ns/op"
+            << " | " << std::setw(10) << "mean" << " |\n";
+    }
+
+    void print(const std::string &primitive, unsigned long ops, double seconds, double mean) const {
+        std::cout << "| " << std::left << std::setw(24) << instance << std::right
+            << " | " << std::setw(4) << k
+            << " | " << std::left << std::setw(28) << primitive << std::right
+            << " | " << std::setw(10) << ops
+            << " | " << std::setw(10) << std::fixed << std::setprecision(2)
+            << (ops > 0 ? seconds * 1e9 / ops : 0.0)
+            << " | " << std::setw(10) << std::setprecision(3) << mean << " |\n";
+    }
+
+    // best time of f over all repetitions, f returns the sum of its results
+    template <typename F>
+    double best_of(F &&f, unsigned long long &sum) {
+        double best = 0.0;
+        ChronoTimer t;
+        for (auto r = 0U; r < repetitions; r++) {
+            t.restart();
+            sum = f();
+            auto time = t.elapsed();
+            if (r == 0 || time < best) {
+                best = time;
+            }
+        }
+        return best;
+    }
+
+    void matching_free_color() {
+        unsigned long long sum = 0;
+        auto time = best_of([this] {
+            unsigned long long s = 0;
+            for (auto *a : arcs) {
+                s += kec.matching_free_color(a->getTail(), a->getHead());
+            }
+            return s;
+        }, sum);
+        print("matching_free_color", arcs.size(), time, static_cast<double>(sum) / arcs.size());
+    }
+
+    void set_unset_edge_color() {
+        std::vector<Arc*> colored;
+        for (auto *a : arcs) {
+            if (kec.edge_color(a) != kec.UNCOLORED) {
+                colored.push_back(a);
+            }
+        }
+        unsigned long long sum = 0;
+        auto time = best_of([this,&colored] {
+            unsigned long long s = 0;
+            for (auto *a : colored) {
+                const auto c = kec.edge_color(a);
+                kec.unset_edge_color(a);
+                kec.set_edge_color(a, c);
+                s += c;
+            }
+            return s;
+        }, sum);
+        print("unset + set_edge_color", colored.size(), time,
+                colored.empty() ? 0.0 : static_cast<double>(sum) / colored.size());
+    }
+
+    void quicker_fan() {
+        std::vector<Arc*> uncolored;
+        for (auto *a : arcs) {
+            if (kec.edge_color(a) == kec.UNCOLORED) {
+                uncolored.push_back(a);
+            }
+        }
+        unsigned long long sum = 0;
+        auto time = best_of([this,&uncolored] {
+            unsigned long long s = 0;
+            for (auto *a : uncolored) {
+                s += kec.quicker_fan(a->getTail(), a).size();
+            }
+            return s;
+        }, sum);
+        print("kEdgeColoring::quicker_fan", uncolored.size(), time,
+                uncolored.empty() ? 0.0 : static_cast<double>(sum) / uncolored.size());
+    }
+
+    void invert_cd_path_it() {
+        // x with a free color c and a used color d, so that a cd-path
+        // starts at x; inverting it twice restores the coloring
+        struct cd_path {
+            Vertex *x;
+            color_t c;
+            color_t d;
+        };
+        std::vector<cd_path> paths;
+        graph.mapVertices([this,&paths] (Vertex *x) {
+            const auto c = kec.find_free_color(x);
+            if (c >= k) {
+                return;
+            }
+            for (color_t d = 0; d < k; d++) {
+                if (kec.arcToMate[d][x] != nullptr) {
+                    paths.push_back({x, c, d});
+                    return;
+                }
+            }
+        });
+        unsigned long long sum = 0;
+        auto time = best_of([this,&paths] {
+            unsigned long long s = 0;
+            for (const auto &p : paths) {
+                s += kec.invert_cd_path_it(p.x, p.c, p.d);
+                kec.invert_cd_path_it(p.x, p.d, p.c);
+            }
+            return s;
+        }, sum);
+        print("kEdgeColoring::invert_cd_path_it", 2 * paths.size(), time,
+                paths.empty() ? 0.0 : static_cast<double>(sum) / paths.size());
+    }
+
+    void add_if_applicable() {
+        unsigned long long sum = 0;
+        double best = 0.0;
+        ChronoTimer t;
+        for (auto r = 0U; r < repetitions; r++) {
+            path_set paths(&graph, graph.getSize());
+            unsigned long long s = 0;
+            t.restart();
+            for (auto *a : arcs) {
+                s += paths.add_if_applicable(a);
+            }
+            auto time = t.elapsed();
+            if (r == 0 || time < best) {
+                best = time;
+            }
+            sum = s;
+        }
+        print("path_set::add_if_applicable", arcs.size(), best, static_cast<double>(sum) / arcs.size());
+    }
+
+    void first_free_matching_color() {
+        // free colors per vertex as kept by node_centered
+        FastPropertyMap<std::vector<char>> free_colors(std::vector<char>(k, true), "", graph.getSize());
+        graph.mapVertices([this,&free_colors] (Vertex *v) {
+            for (color_t c = 0; c < k; c++) {
+                free_colors[v][c] = kec.arcToMate[c][v] == nullptr;
+            }
+        });
+        unsigned long long sum = 0;
+        auto time = best_of([this,&free_colors] {
+            unsigned long long s = 0;
+            for (auto *a : arcs) {
+                s += node_centered::first_free_matching_color(free_colors[a->getFirst()], free_colors[a->getSecond()]);
+            }
+            return s;
+        }, sum);
+        print("node_centered::first_free_*", arcs.size(), time, static_cast<double>(sum) / arcs.size());
+    }
+
+    void property_map_access() {
+        auto &edge_color = kec.edge_color;
+        auto &mate = kec.mate[0];
+        std::vector<color_t> raw_color;
+        std::vector<Vertex*> raw_mate(graph.getSize(), nullptr);
+        for (auto *a : arcs) {
+            if (a->getId() >= raw_color.size()) {
+                raw_color.resize(a->getId() + 1, kec.UNCOLORED);
+            }
+            raw_color[a->getId()] = edge_color(a);
+        }
+        graph.mapVertices([&mate,&raw_mate] (Vertex *v) {
+            raw_mate[v->getId()] = mate[v];
+        });
+
+        unsigned long long sum_map = 0, sum_raw = 0;
+        auto time_map = best_of([this,&edge_color,&mate] {
+            unsigned long long s = 0;
+            for (auto *a : arcs) {
+                s += edge_color[a] != kec.UNCOLORED;
+                s += mate[a->getTail()] == a->getHead();
+            }
+            return s;
+        }, sum_map);
+        auto time_raw = best_of([this,&raw_color,&raw_mate] {
+            unsigned long long s = 0;
+            for (auto *a : arcs) {
+                s += raw_color[a->getId()] != kec.UNCOLORED;
+                s += raw_mate[a->getTail()->getId()] == a->getHead();
+            }
+            return s;
+        }, sum_raw);
+        if (sum_map != sum_raw) {
+            std::cerr << "Error: FastPropertyMap and vector differ for " << instance << ", k = " << k << "\n";
+        }
+        print("FastPropertyMap color+mate", 2 * arcs.size(), time_map, static_cast<double>(sum_map) / arcs.size());
+        print("std::vector color+mate", 2 * arcs.size(), time_raw, static_cast<double>(sum_raw) / arcs.size());
+    }
+
+    void run_all() {
+        matching_free_color();
+        set_unset_edge_color();
+        quicker_fan();
+        invert_cd_path_it();
+        add_if_applicable();
+        first_free_matching_color();
+        property_map_access();
+    }
+};
+
+int main(int argc, char **argv) {
+    unsigned log_n = argc > 1 ? std::atoi(argv[1]) : 16;
+    unsigned log_m = argc > 2 ? std::atoi(argv[2]) : 20;
+    unsigned max_k = argc > 3 ? std::atoi(argv[3]) : 32;
+    unsigned reps = argc > 4 ? std::atoi(argv[4]) : 3;
+
+    if (argc > 5 || log_n == 0 || log_m < log_n || max_k == 0 || reps == 0) {
+        std::cerr << "Usage: " << argv[0] << " [log_n] [log_m] [max_k] [repetitions]\n";
+        return 1;
+    }
+
+    bool header = true;
+    for (auto type : all_instance_types()) {
+        instance_params params;
+        params.type = type;
+        params.log_n = log_n;
+        params.log_m = log_m;
+        params.weight_mean = static_cast<double>(1UL << log_m);
+        primitive_bench bench(params, reps);
+        if (header) {
+            bench.print_header();
+            header = false;
+        }
+        for (auto k = 1U; k <= max_k; k *= 2) {
+            if (!bench.color(k)) {
+                std::cerr << "Error: k-Edge Coloring failed for " << bench.instance << ", k = " << k << "\n";
+                return 1;
+            }
+            bench.run_all();
+        }
+    }
+    return 0;
+}
@@ -39,6 +39,31 @@ int parse_matching_parameters(int argn, char **argv,  MatchingConfig &matching_c
     struct arg_str *algorithm = arg_strn("a", "algorithm", NULL, 0, 5, "single algorithm to run. any of: nodecentered, bmatching, biterative, gpa, bgreedy-extend, bgreedy-color, greedy-it, gpa-it, k-ec");
     struct arg_str *aggregation_type = arg_strn("g", "aggregation-type", NULL, 0, 5, "aggregation type to use for node centered. any of: sum, max, avg, median, bsum");
     struct arg_lit *global_swaps = arg_lit0(NULL, "global-swaps", "use global swaps instead of local (ie after end of iterations instead of after each it.)");
+    struct arg_str *solution_output = arg_str0(NULL, "solution-output", "FILE", "write the matchings found to FILE (with several algorithms or b: FILE.<algorithm>.b<b>)");
+    struct arg_str *solution_format = arg_str0(NULL, "solution-format", "FORMAT", "format for --solution-output: text (lines \"tail head color\", default) or binary (per-matching mate arrays of 32-bit vertex ids)");
+    struct arg_lit *solution_mmap = arg_lit0(NULL, "solution-mmap", "write --solution-output through a memory mapping");
+    struct arg_str *stream_matchings = arg_str0(NULL, "stream-matchings", "FILE", "write each matching to FILE (may be a FIFO) as soon as it is final; GreedyIt and GPA publish matchings while still computing later ones");
+    struct arg_str *normalize = arg_str0(NULL, "normalize", "COMBINE", "merge antiparallel and parallel arcs into one undirected edge, combining weights by sum or max, and drop self-loops and arcs of weight 0 before solving");
+    struct arg_str *reorder = arg_str0(NULL, "reorder", "ORDER", "with --normalize: renumber the vertices for locality by degree, rcm (reverse Cuthill-McKee) or community (label propagation); output uses the input ids");
+    struct arg_lit *components = arg_lit0(NULL, "components", "solve each connected component separately, on up to --threads components concurrently, and merge the solutions");
+    struct arg_lit *incremental_b = arg_lit0(NULL, "incremental-b", "run GreedyIt and GPA only once for the largest b and report the first b' matchings for every smaller b' (other algorithms are rerun per b)");
+    struct arg_int *parallel_algorithms = arg_int0(NULL, "parallel-algorithms", "N", "run up to N algorithms concurrently (0: one per core)");
+    struct arg_int *threads = arg_int0(NULL, "threads", "N", "number of threads for parallel modes (default 0: one per core)");
+    struct arg_lit *dynamic = arg_lit0(NULL, "dynamic", "after solving the first delta (timestamp) of the input, apply all further deltas and repair each solution locally; requires sequential execution");
+    struct arg_int *window = arg_int0(NULL, "window", "LENGTH", "streaming mode: aggregate the demand of all records within a time window of LENGTH timestamps and solve each window, reusing the previous solution");
+    struct arg_int *window_slide = arg_int0(NULL, "window-slide", "STEP", "advance the window by STEP timestamps (default: LENGTH, i.e., tumbling windows)");
+    struct arg_str *window_output = arg_str0(NULL, "window-output", "FILE", "write the matching of each window to FILE, vertices given by their input labels");
+    struct arg_int *switch_penalty = arg_int0(NULL, "switch-penalty", "P", "with --dynamic or --window: each link added to or removed from a matching by a repair costs P, repairs maximize weight minus switching cost");
+    struct arg_str *diff_output = arg_str0(NULL, "diff-output", "FILE", "with --dynamic or --window: write the links changed per matching by each repair to FILE");
+    struct arg_str *warm_start = arg_str0(NULL, "warm-start", "FILE", "start the algorithms from the solution in FILE (lines \"tail head color\"), pruning links that are invalid for the input");
+    struct arg_int *gpa_seeds = arg_int0(NULL, "gpa-seeds", "N", "run GPA (with --swaps or -l for ROMA) for N seeds starting at --seed in parallel and report the best solution");
+    struct arg_int *portfolio_deadline = arg_int0(NULL, "portfolio-deadline", "MS", "anytime mode: run a portfolio of algorithms and report the best solution found within MS milliseconds");
+    struct arg_lit *phase_times = arg_lit0(NULL, "phase-times", "print the time spent in each phase (sorting, rounds, swaps, ...) below the result of each algorithm");
+    struct arg_str *phase_output = arg_str0(NULL, "phase-output", "FILE", "append the time spent in each phase of each algorithm to the CSV file FILE");
+    struct arg_str *trace_output = arg_str0(NULL, "trace-output", "FILE", "write a timeline of loading, normalization, the phases of all algorithms and output per thread to FILE (Chrome trace-event JSON, view in ui.perfetto.dev)");
+    struct arg_lit *perf_counters = arg_lit0(NULL, "perf-counters", "record cycles, instructions, LLC, dTLB and branch misses of each algorithm and phase via perf_event_open (Linux, calling thread only)");
+    struct arg_lit *upper_bounds = arg_lit0(NULL, "upper-bounds", "compute upper bounds on the optimum for each b (top-b incident weights, fractional b-matching) and report each weight relative to them");
+    struct arg_lit *event_counters = arg_lit0(NULL, "event-counters", "print the swaps, fan sizes, cd-path lengths, path and cycle lengths and ROMA iterations of each algorithm below its result");
 
 
     struct arg_str *filename = arg_strn(NULL, NULL, "FILE", 1, 1, "Path to graph file to partition.");
@@ -54,6 +79,15 @@ int parse_matching_parameters(int argn, char **argv,  MatchingConfig &matching_c
             algorithm,
             aggregation_type,
             global_swaps,
+            normalize, reorder, components, incremental_b, stream_matchings,
+            solution_output, solution_format, solution_mmap,
+            parallel_algorithms, threads,
+            portfolio_deadline, gpa_seeds,
+            dynamic,
+            window, window_slide, window_output,
+            switch_penalty, diff_output,
+            warm_start,
+            phase_times, phase_output, perf_counters, event_counters, upper_bounds, trace_output,
             console_log, b, l,
             seed, oseed,
             sanitycheck, outfile,
@@ -200,12 +234,246 @@ int parse_matching_parameters(int argn, char **argv,  MatchingConfig &matching_c
         matching_config.swaps_global = true;
     }
 
+    if (solution_output->count > 0) {
+        matching_config.solution_output = solution_output->sval[0];
+    }
+
+    if (solution_format->count > 0) {
+        std::string format = solution_format->sval[0];
+        if (format.compare("binary") == 0) {
+            matching_config.solution_binary = true;
+        } else if (format.compare("text") != 0) {
+            printf("Invalid solution format passed! %s\n", format.c_str());
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+    }
+
+    if (solution_mmap->count > 0) {
+        matching_config.solution_mmap = true;
+    }
+
+    if (stream_matchings->count > 0) {
+        matching_config.stream_matchings = stream_matchings->sval[0];
+    }
+
+    if (normalize->count > 0) {
+        std::string combine = normalize->sval[0];
+        if (combine.compare("sum") == 0) {
+            matching_config.normalize = NORMALIZE_SUM;
+        } else if (combine.compare("max") == 0) {
+            matching_config.normalize = NORMALIZE_MAX;
+        } else {
+            printf("Invalid normalization passed! %s\n", combine.c_str());
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+    }
+
+    if (reorder->count > 0) {
+        std::string order = reorder->sval[0];
+        if (order.compare("degree") == 0) {
+            matching_config.vertex_order = DEGREE_ORDER;
+        } else if (order.compare("rcm") == 0) {
+            matching_config.vertex_order = RCM_ORDER;
+        } else if (order.compare("community") == 0) {
+            matching_config.vertex_order = COMMUNITY_ORDER;
+        } else if (order.compare("input") != 0) {
+            printf("Invalid vertex order passed! %s\n", order.c_str());
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+    }
+
+    if (components->count > 0) {
+        matching_config.components = true;
+    }
+
+    if (incremental_b->count > 0) {
+        matching_config.incremental_b = true;
+    }
+
+    if (parallel_algorithms->count > 0) {
+        if (parallel_algorithms->ival[0] < 0) {
+            printf("Invalid number of parallel algorithms passed! %d\n", parallel_algorithms->ival[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        matching_config.parallel_algorithms = parallel_algorithms->ival[0];
+    }
+
+    if (threads->count > 0) {
+        if (threads->ival[0] < 0) {
+            printf("Invalid number of threads passed! %d\n", threads->ival[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        matching_config.threads = threads->ival[0];
+    }
+
+    if (dynamic->count > 0) {
+        matching_config.dynamic = true;
+    }
+
+    if (window->count > 0) {
+        if (window->ival[0] <= 0) {
+            printf("Invalid window length passed! %d\n", window->ival[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        matching_config.window_length = window->ival[0];
+        matching_config.window_slide = window->ival[0];
+    }
+
+    if (window_slide->count > 0) {
+        if (window_slide->ival[0] <= 0 || window->count == 0) {
+            printf("--window-slide requires --window and a positive step.\n");
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        matching_config.window_slide = window_slide->ival[0];
+    }
+
+    if (window_output->count > 0) {
+        matching_config.window_output = window_output->sval[0];
+    }
+
+    if (switch_penalty->count > 0) {
+        if (switch_penalty->ival[0] < 0) {
+            printf("Invalid switch penalty passed! %d\n", switch_penalty->ival[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        matching_config.switch_penalty = switch_penalty->ival[0];
+    }
+
+    if (diff_output->count > 0) {
+        matching_config.diff_output = diff_output->sval[0];
+    }
+
+    if ((switch_penalty->count > 0 || diff_output->count > 0)
+            && !matching_config.dynamic && window->count == 0) {
+        printf("--switch-penalty and --diff-output require --dynamic or --window.\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    if (warm_start->count > 0) {
+        matching_config.warm_start_file = warm_start->sval[0];
+    }
+
+    if (phase_times->count > 0) {
+        matching_config.phase_times = true;
+    }
+
+    if (phase_output->count > 0) {
+        matching_config.phase_output = phase_output->sval[0];
+    }
+
+    if (perf_counters->count > 0) {
+        matching_config.perf_counters = true;
+    }
+
+    if (event_counters->count > 0) {
+        matching_config.event_counters = true;
+    }
+
+    if (upper_bounds->count > 0) {
+        matching_config.upper_bounds = true;
+    }
+
+    if (trace_output->count > 0) {
+        matching_config.trace_output = trace_output->sval[0];
+    }
+
+    if (gpa_seeds->count > 0) {
+        if (gpa_seeds->ival[0] <= 0) {
+            printf("Invalid number of GPA seeds passed! %d\n", gpa_seeds->ival[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        matching_config.gpa_seeds = gpa_seeds->ival[0];
+    }
+
+    if (portfolio_deadline->count > 0) {
+        if (portfolio_deadline->ival[0] <= 0) {
+            printf("Invalid portfolio deadline passed! %d\n", portfolio_deadline->ival[0]);
+            arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+            return 1;
+        }
+        matching_config.portfolio_deadline_ms = portfolio_deadline->ival[0];
+    }
+
 
     if (outfile->count > 0) {
         matching_config.outputFile = outfile->sval[0];
         matching_config.writeOutputfile = true;
     }
 
+    if (!matching_config.solution_output.empty() && matching_config.window_length > 0) {
+        printf("--solution-output can't be combined with --window.\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    if (matching_config.incremental_b && (matching_config.dynamic || matching_config.parallel_algorithms != 1)) {
+        printf("--incremental-b can't be combined with --dynamic or --parallel-algorithms.\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    if (!matching_config.stream_matchings.empty() && (matching_config.incremental_b
+                || matching_config.parallel_algorithms != 1 || matching_config.window_length > 0
+                || !matching_config.warm_start_file.empty()
+                || matching_config.gpa_seeds > 0 || matching_config.portfolio_deadline_ms > 0)) {
+        printf("--stream-matchings can't be combined with --incremental-b, --parallel-algorithms, --window, --warm-start, --gpa-seeds, or --portfolio-deadline.\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    if (matching_config.normalize != NO_NORMALIZE && (matching_config.dynamic
+                || matching_config.window_length > 0)) {
+        printf("--normalize can't be combined with --dynamic or --window.\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    if (matching_config.vertex_order != INPUT_ORDER && matching_config.normalize == NO_NORMALIZE) {
+        printf("--reorder requires --normalize.\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    if (matching_config.components && (matching_config.incremental_b || matching_config.dynamic
+                || matching_config.window_length > 0 || !matching_config.stream_matchings.empty()
+                || !matching_config.warm_start_file.empty()
+                || matching_config.gpa_seeds > 0 || matching_config.portfolio_deadline_ms > 0)) {
+        printf("--components can't be combined with --incremental-b, --dynamic, --window, --stream-matchings, --warm-start, --gpa-seeds, or --portfolio-deadline.\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    if (matching_config.dynamic && matching_config.parallel_algorithms != 1) {
+        printf("--dynamic can't be combined with --parallel-algorithms.\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    if (matching_config.window_length > 0 && (matching_config.dynamic
+                || matching_config.parallel_algorithms != 1
+                || matching_config.gpa_seeds > 0 || matching_config.portfolio_deadline_ms > 0)) {
+        printf("--window can't be combined with --dynamic, --parallel-algorithms, --gpa-seeds, or --portfolio-deadline.\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
+    if (!matching_config.warm_start_file.empty() && (matching_config.window_length > 0
+                || matching_config.gpa_seeds > 0 || matching_config.portfolio_deadline_ms > 0)) {
+        printf("--warm-start can't be combined with --window, --gpa-seeds, or --portfolio-deadline.\n");
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 1;
+    }
+
     arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
 
     return 0;
@@ -0,0 +1,68 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#pragma once
+
+#include <ostream>
+#include <string>
+
+#include "matching/matching_config.h"
+#include "matching/matching_defs.h"
+#include "tools/allocation_counter.h"
+#include "tools/perf_counters.h"
+
+// result of one run of an algorithm for one b
+struct algorithm_result {
+    bool prepared{false};
+    EdgeWeight weight{0};
+    double time{0.0};
+    double cpu_time{0.0};
+    // hardware counters of run(), invalid if not collected
+    PerfSample counters;
+    // memory of set_num_matchings(), prepare() and run(): growth of the
+    // peak resident set size and allocations via operator new
+    long rss_delta_kb{0};
+    AllocationStats allocations;
+    // upper bounds on the optimum for the same b, 0 if not computed
+    EdgeWeight top_b_bound{0};
+    EdgeWeight fractional_bound{0};
+};
+
+// header of the results CSV file, one row per run
+constexpr const char *RESULTS_CSV_HEADER = "graph,b,seed,l,threshold_global,algorithm,time,weight,cpu_time,"
+    "cycles,instructions,llc_misses,dtlb_misses,branch_misses,"
+    "rss_delta_kb,alloc_bytes,allocs,top_b_bound,fractional_bound\n";
+
+// CSV columns of the hardware counters, empty if invalid
+inline void write_counters(std::ostream &out, const PerfSample &counters) {
+    for (auto c = 0; c < PerfSample::NUM_COUNTERS; c++) {
+        out << ",";
+        if (counters.valid[c]) {
+            out << counters.values[c];
+        }
+    }
+}
+
+// row of the results CSV for a run on config.graph_filename with config.b
+inline void write_result_row(std::ostream &out, const MatchingConfig &config, int seed, double threshold,
+        const std::string &short_name, const algorithm_result &result) {
+    out << config.graph_filename << "," << config.b << ","
+        << seed << "," << config.l << ","
+        << threshold << ","
+        << short_name << "," << result.time << "," << result.weight
+        << "," << result.cpu_time;
+    write_counters(out, result.counters);
+    out << "," << result.rss_delta_kb << "," << result.allocations.bytes
+        << "," << result.allocations.count << ",";
+    if (result.top_b_bound > 0) {
+        out << result.top_b_bound;
+    }
+    out << ",";
+    if (result.fractional_bound > 0) {
+        out << result.fractional_bound;
+    }
+    out << "\n";
+}
@@ -0,0 +1,142 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#include "tools/allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<unsigned long long> total_bytes{0};
+std::atomic<unsigned long long> total_count{0};
+// trivial types only, so that no thread_local initialization can
+// allocate itself
+thread_local unsigned long long thread_bytes = 0;
+thread_local unsigned long long thread_count = 0;
+
+inline void count_allocation(std::size_t size) noexcept {
+    total_bytes.fetch_add(size, std::memory_order_relaxed);
+    total_count.fetch_add(1, std::memory_order_relaxed);
+    thread_bytes += size;
+    thread_count++;
+}
+
+inline void *allocate(std::size_t size) noexcept {
+    count_allocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+inline void *allocate_aligned(std::size_t size, std::align_val_t alignment) noexcept {
+    count_allocation(size);
+    void *ptr = nullptr;
+    auto align = static_cast<std::size_t>(alignment);
+    if (align < sizeof(void*)) {
+        align = sizeof(void*);
+    }
+    if (posix_memalign(&ptr, align, size == 0 ? 1 : size) != 0) {
+        return nullptr;
+    }
+    return ptr;
+}
+
+inline void *allocate_or_throw(void *ptr) {
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+}
+
+AllocationStats process_allocations() noexcept {
+    return {total_bytes.load(std::memory_order_relaxed), total_count.load(std::memory_order_relaxed)};
+}
+
+AllocationStats thread_allocations() noexcept {
+    return {thread_bytes, thread_count};
+}
+
+void *operator new(std::size_t size) {
+    return allocate_or_throw(allocate(size));
+}
+
+void *operator new[](std::size_t size) {
+    return allocate_or_throw(allocate(size));
+}
+
+void *operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate_or_throw(allocate_aligned(size, alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocate_or_throw(allocate_aligned(size, alignment));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_aligned(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_aligned(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
@@ -0,0 +1,28 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+// number and total size of the allocations via operator new; counted by
+// the replacements of the global operator new in allocation_counter.cpp,
+// so they are only available in executables linking that file
+struct AllocationStats {
+        unsigned long long bytes{0};
+        unsigned long long count{0};
+
+        AllocationStats operator-(const AllocationStats &rhs) const noexcept {
+            return {bytes - rhs.bytes, count - rhs.count};
+        }
+};
+
+// allocations of all threads since the start of the process
+AllocationStats process_allocations() noexcept;
+
+// allocations of the calling thread since its start
+AllocationStats thread_allocations() noexcept;
+
+#endif /* ALLOCATION_COUNTER_H */
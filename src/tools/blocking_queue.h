@@ -0,0 +1,54 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#ifndef BLOCKING_QUEUE_H
+#define BLOCKING_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// unbounded FIFO queue for handing items from producers to consumers
+template<typename T>
+class blocking_queue {
+    public:
+        void push(T item) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                items.push_back(std::move(item));
+            }
+            not_empty.notify_one();
+        }
+
+        // no more items will be pushed, pop() returns false once empty
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                closed = true;
+            }
+            not_empty.notify_all();
+        }
+
+        // waits for the next item, returns false if closed and empty
+        bool pop(T &item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_empty.wait(lock, [this] () { return closed || !items.empty(); });
+            if (items.empty()) {
+                return false;
+            }
+            item = std::move(items.front());
+            items.pop_front();
+            return true;
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable not_empty;
+        std::deque<T> items;
+        bool closed{false};
+};
+
+#endif /* BLOCKING_QUEUE_H */
@@ -7,7 +7,20 @@
 #ifndef CHRONOTIMER_H
 #define CHRONOTIMER_H
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tools/perf_counters.h"
+#include "tools/trace.h"
+
+#ifndef DJM_PHASE_TIMERS
+#define DJM_PHASE_TIMERS 1
+#endif
 
 class ChronoTimer {
         public:
@@ -18,16 +31,14 @@ class ChronoTimer {
                 }
 
                 template<typename time_unit = std::chrono::seconds>
-                long long int elapsed_integral() {
-                    static std::chrono::steady_clock::time_point stop_time;
-                    stop_time = std::chrono::steady_clock::now();
+                long long int elapsed_integral() const {
+                    const auto stop_time = std::chrono::steady_clock::now();
                     return std::chrono::duration_cast<time_unit>(stop_time - start_time).count();
                 }
 
                 template<typename unit = std::ratio<1>>
-                double elapsed() {
-                    static std::chrono::steady_clock::time_point stop_time;
-                    stop_time = std::chrono::steady_clock::now();
+                double elapsed() const {
+                    const auto stop_time = std::chrono::steady_clock::now();
                     std::chrono::duration<double, unit> delta = stop_time - start_time;
                     return delta.count();
                 }
@@ -36,4 +47,258 @@ class ChronoTimer {
                 std::chrono::steady_clock::time_point start_time;
 };
 
+// measures the CPU time consumed by the calling thread
+class ThreadCpuTimer {
+        public:
+                ThreadCpuTimer() : start_time(now()) { }
+
+                void restart() {
+                    start_time = now();
+                }
+
+                // in seconds
+                double elapsed() const {
+                    return now() - start_time;
+                }
+
+        private:
+                double start_time;
+
+                static double now() {
+                    timespec ts;
+                    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+                    return ts.tv_sec + ts.tv_nsec * 1e-9;
+                }
+};
+
+// accumulated wall-clock times of nested phases, e.g., "round" within
+// "matching"; a phase entered several times within the same parent,
+// e.g., once per round, is a single entry with the total time.
+// With hardware counters set, the counter values are accumulated per
+// phase as well.
+class PhaseTimes {
+        public:
+                struct phase {
+                    std::string name;
+                    std::size_t parent;
+                    double seconds;
+                    unsigned long count;
+                    std::vector<std::size_t> children;
+                    PerfSample counters;
+                };
+                static constexpr std::size_t ROOT = ~static_cast<std::size_t>(0);
+
+                void clear() {
+                    entries.clear();
+                    roots.clear();
+                    open.clear();
+                    open_samples.clear();
+                }
+
+                // counters of the thread that enters and leaves the phases,
+                // nullptr for time only; kept by clear()
+                void set_counters(const PerfCounters *counters) {
+                    perf = counters;
+                    open_samples.clear();
+                }
+
+                bool empty() const noexcept {
+                    return entries.empty();
+                }
+
+                // enters the phase name within the innermost open phase
+                std::size_t enter(const char *name) {
+                    const auto index = child(name);
+                    open.push_back(index);
+                    if (perf != nullptr) {
+                        open_samples.push_back(perf->read());
+                    }
+                    return index;
+                }
+
+                // adds seconds and count to the phase name within the
+                // innermost open phase without entering it, e.g., for the
+                // totals of StepTimes
+                void add(const char *name, double seconds, unsigned long count) {
+                    const auto index = child(name);
+                    entries[index].seconds += seconds;
+                    entries[index].count += count;
+                }
+
+                void leave(std::size_t index, double seconds) {
+                    entries[index].seconds += seconds;
+                    entries[index].count++;
+                    open.pop_back();
+                    if (perf != nullptr && !open_samples.empty()) {
+                        entries[index].counters += perf->read() - open_samples.back();
+                        open_samples.pop_back();
+                    }
+                }
+
+                // adds the phases of other within the innermost open phase,
+                // e.g., those of a subroutine with its own times
+                void merge(const PhaseTimes &other) {
+                    for (auto r : other.roots) {
+                        merge_subtree(other, r);
+                    }
+                }
+
+                // calls fn(phase, depth) for all phases, parents before
+                // their children, siblings in the order first entered
+                template<typename F>
+                void map_phases(F &&fn) const {
+                    for (auto r : roots) {
+                        map_subtree(r, 0, fn);
+                    }
+                }
+
+                // names from the outermost phase down to phase, joined by "/"
+                std::string path(std::size_t index) const {
+                    std::string p = entries[index].name;
+                    for (auto i = entries[index].parent; i != ROOT; i = entries[i].parent) {
+                        p = entries[i].name + "/" + p;
+                    }
+                    return p;
+                }
+
+                const phase &operator[](std::size_t index) const {
+                    return entries[index];
+                }
+
+        private:
+                std::vector<phase> entries;
+                std::vector<std::size_t> roots;
+                std::vector<std::size_t> open;
+                const PerfCounters *perf{nullptr};
+                std::vector<PerfSample> open_samples;
+
+                // the phase name within the innermost open phase, added if new
+                std::size_t child(const char *name) {
+                    const auto parent = open.empty() ? ROOT : open.back();
+                    auto &siblings = parent == ROOT ? roots : entries[parent].children;
+                    for (auto s : siblings) {
+                        if (entries[s].name == name) {
+                            return s;
+                        }
+                    }
+                    const auto index = entries.size();
+                    siblings.push_back(index);
+                    entries.push_back({name, parent, 0.0, 0, {}, {}});
+                    return index;
+                }
+
+                void merge_subtree(const PhaseTimes &other, std::size_t index) {
+                    const auto &theirs = other.entries[index];
+                    const auto mine = enter(theirs.name.c_str());
+                    entries[mine].seconds += theirs.seconds;
+                    entries[mine].count += theirs.count;
+                    entries[mine].counters += theirs.counters;
+                    for (auto c : theirs.children) {
+                        merge_subtree(other, c);
+                    }
+                    open.pop_back();
+                    if (perf != nullptr) {
+                        open_samples.pop_back();
+                    }
+                }
+
+                template<typename F>
+                void map_subtree(std::size_t index, unsigned depth, F &&fn) const {
+                    fn(index, depth);
+                    for (auto c : entries[index].children) {
+                        map_subtree(c, depth + 1, fn);
+                    }
+                }
+};
+
+// accumulated wall-clock times of steps that are too short and too
+// frequent for ScopedPhase, e.g., building the fan of each colored arc.
+// Steps are timed as laps: lap(step) adds the time since the last
+// start() or lap() to step, so each step costs a single clock read and
+// records neither hardware counters nor trace spans.
+class StepTimes {
+        public:
+                // step i is reported as names[i]
+                explicit StepTimes(std::vector<const char*> names)
+                    : names(std::move(names)), seconds(this->names.size(), 0.0),
+                      counts(this->names.size(), 0) { }
+
+                void clear() {
+                    std::fill(seconds.begin(), seconds.end(), 0.0);
+                    std::fill(counts.begin(), counts.end(), 0);
+                }
+
+                void start() {
+                    last = std::chrono::steady_clock::now();
+                }
+
+                void lap(std::size_t step) {
+                    const auto now = std::chrono::steady_clock::now();
+                    seconds[step] += std::chrono::duration<double>(now - last).count();
+                    counts[step]++;
+                    last = now;
+                }
+
+                // adds all steps that occurred as phases within the
+                // innermost open phase of times
+                void add_to(PhaseTimes &times) const {
+                    for (auto i = 0UL; i < names.size(); i++) {
+                        if (counts[i] > 0) {
+                            times.add(names[i], seconds[i], counts[i]);
+                        }
+                    }
+                }
+
+        private:
+                std::vector<const char*> names;
+                std::vector<double> seconds;
+                std::vector<unsigned long> counts;
+                std::chrono::steady_clock::time_point last;
+};
+
+// adds the time from construction to destruction to a phase
+class ScopedPhase {
+        public:
+                ScopedPhase(PhaseTimes &times, const char *name)
+                    : times(times), index(times.enter(name)) { }
+
+                ~ScopedPhase() {
+                    times.leave(index, timer.elapsed());
+                }
+
+                ScopedPhase(const ScopedPhase&) = delete;
+                ScopedPhase &operator=(const ScopedPhase&) = delete;
+
+        private:
+                PhaseTimes &times;
+                std::size_t index;
+                ChronoTimer timer;
+};
+
+// DJM_PHASE(times, "name"); times the rest of the enclosing scope as
+// phase "name"; DJM_TRACED_PHASE(times, "name"); also records it as a
+// span of the trace if tracing is enabled, which is meant for the coarse
+// phases of an algorithm (e.g., sort, rounds, coloring), not for phases
+// entered many times per run. Both compile to nothing with
+// DJM_PHASE_TIMERS=0
+#define DJM_PHASE_CONCAT_(a, b) a##b
+#define DJM_PHASE_CONCAT(a, b) DJM_PHASE_CONCAT_(a, b)
+#if DJM_PHASE_TIMERS
+#define DJM_PHASE(times, name) ScopedPhase DJM_PHASE_CONCAT(djm_phase_, __LINE__)((times), (name))
+#define DJM_TRACED_PHASE(times, name) DJM_PHASE(times, name); DJM_TRACE(name)
+#else
+#define DJM_PHASE(times, name) ((void) 0)
+#define DJM_TRACED_PHASE(times, name) ((void) 0)
+#endif
+
+// DJM_STEP_START(steps); and DJM_STEP_LAP(steps, step); time the steps
+// of StepTimes steps, likewise compiled out with DJM_PHASE_TIMERS=0
+#if DJM_PHASE_TIMERS
+#define DJM_STEP_START(steps) (steps).start()
+#define DJM_STEP_LAP(steps, step) (steps).lap(step)
+#else
+#define DJM_STEP_START(steps) ((void) 0)
+#define DJM_STEP_LAP(steps, step) ((void) 0)
+#endif
+
 #endif /* CHRONOTIMER_H */
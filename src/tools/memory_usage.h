@@ -0,0 +1,51 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <fstream>
+#include <string>
+#include <sys/resource.h>
+
+// peak resident set size of the process in KiB since the last
+// reset_peak_rss(), or since the start of the process
+inline long peak_rss_kb() {
+    // VmHWM can be reset, ru_maxrss can't
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::stol(line.substr(6));
+        }
+    }
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// current resident set size of the process in KiB, 0 if unknown
+inline long current_rss_kb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return std::stol(line.substr(6));
+        }
+    }
+    return 0;
+}
+
+// lets peak_rss_kb() start over from the current resident set size;
+// returns false if not supported (Linux >= 4.0 only)
+inline bool reset_peak_rss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+    clear_refs.flush();
+    return clear_refs.good();
+}
+
+#endif /* MEMORY_USAGE_H */
@@ -0,0 +1,54 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// number of threads to use if the user asked for 0, i.e., "all"
+inline unsigned default_num_threads(unsigned requested) {
+    if (requested > 0) {
+        return requested;
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+// calls fn(i) for all 0 <= i < count on up to num_threads threads;
+// tasks are handed out dynamically in increasing order of i
+template<typename F>
+void parallel_for(std::size_t count, unsigned num_threads, F &&fn) {
+    num_threads = std::min<std::size_t>(default_num_threads(num_threads), count);
+    if (num_threads <= 1) {
+        for (std::size_t i = 0; i < count; i++) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next { 0 };
+    auto worker = [&next,&fn,count] () {
+        for (auto i = next++; i < count; i = next++) {
+            fn(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (auto t = 1U; t < num_threads; t++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+#endif /* PARALLEL_H */
@@ -0,0 +1,214 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstdint>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// values of the hardware counters, either absolute or the difference
+// between two reads; counters that could not be opened are invalid
+struct PerfSample {
+        enum counter { CYCLES, INSTRUCTIONS, LLC_MISSES, DTLB_MISSES, BRANCH_MISSES, NUM_COUNTERS };
+
+        unsigned long long values[NUM_COUNTERS] = {0, 0, 0, 0, 0};
+        bool valid[NUM_COUNTERS] = {false, false, false, false, false};
+
+        static const char *name(counter c) {
+            static const char *names[NUM_COUNTERS] = {
+                "cycles", "instructions", "llc_misses", "dtlb_misses", "branch_misses"
+            };
+            return names[c];
+        }
+
+        bool any_valid() const noexcept {
+            for (auto v : valid) {
+                if (v) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // instructions per cycle, 0 if unknown
+        double ipc() const noexcept {
+            if (!valid[CYCLES] || !valid[INSTRUCTIONS] || values[CYCLES] == 0) {
+                return 0.0;
+            }
+            return static_cast<double>(values[INSTRUCTIONS]) / values[CYCLES];
+        }
+
+        PerfSample operator-(const PerfSample &rhs) const noexcept {
+            PerfSample diff;
+            for (auto c = 0; c < NUM_COUNTERS; c++) {
+                diff.valid[c] = valid[c] && rhs.valid[c];
+                diff.values[c] = diff.valid[c] && values[c] > rhs.values[c] ? values[c] - rhs.values[c] : 0;
+            }
+            return diff;
+        }
+
+        PerfSample &operator+=(const PerfSample &rhs) noexcept {
+            for (auto c = 0; c < NUM_COUNTERS; c++) {
+                if (rhs.valid[c]) {
+                    values[c] += rhs.values[c];
+                    valid[c] = true;
+                }
+            }
+            return *this;
+        }
+};
+
+// hardware counters (cycles, instructions, LLC and dTLB read misses,
+// branch misses) of the calling thread in user space, via perf_event_open;
+// the counters run from construction on and are read as one group,
+// scaled if the kernel had to multiplex them.
+// Counters that are not supported, e.g., in a container or on a virtual
+// machine, are left out; if none can be opened, available() is false
+// and read() returns an invalid sample.
+class PerfCounters {
+        public:
+                PerfCounters() {
+#ifdef __linux__
+                    for (auto c = 0; c < PerfSample::NUM_COUNTERS; c++) {
+                        fds[c] = -1;
+                        open_counter(static_cast<PerfSample::counter>(c));
+                    }
+                    if (leader >= 0) {
+                        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                    }
+#else
+                    error = "not supported on this platform";
+#endif
+                }
+
+                ~PerfCounters() {
+#ifdef __linux__
+                    for (auto fd : fds) {
+                        if (fd >= 0) {
+                            close(fd);
+                        }
+                    }
+#endif
+                }
+
+                PerfCounters(const PerfCounters&) = delete;
+                PerfCounters &operator=(const PerfCounters&) = delete;
+
+                bool available() const noexcept {
+#ifdef __linux__
+                    return leader >= 0;
+#else
+                    return false;
+#endif
+                }
+
+                // why no or not all counters could be opened, empty if all are available
+                const std::string &get_error() const noexcept {
+                    return error;
+                }
+
+                PerfSample read() const {
+                    PerfSample sample;
+#ifdef __linux__
+                    if (leader < 0) {
+                        return sample;
+                    }
+                    // nr, time_enabled, time_running, {value, id} per counter
+                    std::uint64_t buffer[3 + 2 * PerfSample::NUM_COUNTERS];
+                    if (::read(leader, buffer, sizeof(buffer)) < static_cast<ssize_t>(3 * sizeof(std::uint64_t))) {
+                        return sample;
+                    }
+                    const auto nr = buffer[0];
+                    const auto enabled = buffer[1];
+                    const auto running = buffer[2];
+                    const double scale = running > 0 && running < enabled
+                        ? static_cast<double>(enabled) / running : 1.0;
+                    for (auto i = 0UL; i < nr && i < PerfSample::NUM_COUNTERS; i++) {
+                        const auto value = buffer[3 + 2 * i];
+                        const auto id = buffer[4 + 2 * i];
+                        for (auto c = 0; c < PerfSample::NUM_COUNTERS; c++) {
+                            if (fds[c] >= 0 && ids[c] == id) {
+                                sample.values[c] = static_cast<unsigned long long>(value * scale);
+                                sample.valid[c] = running > 0;
+                            }
+                        }
+                    }
+#endif
+                    return sample;
+                }
+
+        private:
+                std::string error;
+#ifdef __linux__
+                int fds[PerfSample::NUM_COUNTERS];
+                std::uint64_t ids[PerfSample::NUM_COUNTERS] = {0, 0, 0, 0, 0};
+                int leader{-1};
+
+                void open_counter(PerfSample::counter c) {
+                    perf_event_attr attr;
+                    std::memset(&attr, 0, sizeof(attr));
+                    attr.size = sizeof(attr);
+                    switch (c) {
+                        case PerfSample::CYCLES:
+                            attr.type = PERF_TYPE_HARDWARE;
+                            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                            break;
+                        case PerfSample::INSTRUCTIONS:
+                            attr.type = PERF_TYPE_HARDWARE;
+                            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                            break;
+                        case PerfSample::LLC_MISSES:
+                            attr.type = PERF_TYPE_HW_CACHE;
+                            attr.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                            break;
+                        case PerfSample::DTLB_MISSES:
+                            attr.type = PERF_TYPE_HW_CACHE;
+                            attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                            break;
+                        default:
+                            attr.type = PERF_TYPE_HARDWARE;
+                            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                            break;
+                    }
+                    attr.disabled = leader < 0 ? 1 : 0;
+                    attr.exclude_kernel = 1;
+                    attr.exclude_hv = 1;
+                    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID
+                        | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                    const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+                    if (fd < 0) {
+                        if (error.empty()) {
+                            error = std::string(PerfSample::name(c)) + ": " + std::strerror(errno);
+                        }
+                        return;
+                    }
+                    if (ioctl(fd, PERF_EVENT_IOC_ID, &ids[c]) != 0) {
+                        close(fd);
+                        return;
+                    }
+                    fds[c] = fd;
+                    if (leader < 0) {
+                        leader = fd;
+                    }
+                }
+#endif
+};
+
+#endif /* PERF_COUNTERS_H */
@@ -0,0 +1,167 @@
+/**
+ * Copyright (C) 2021, 2022 : Kathrin Hanauer, Jonathan Trummer
+ *
+ * This file is part of DJMatch and licensed under GPLv3.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+// Timeline of spans per thread, written as Chrome trace-event JSON
+// (chrome://tracing, ui.perfetto.dev).
+// Each thread appends to a buffer of its own, so recording a span takes
+// no lock; a thread only locks once to register its buffer. The buffers
+// must only be written out when no thread records spans anymore.
+// Span names must outlive the recorder, e.g., string literals or names
+// from intern().
+class TraceRecorder {
+        public:
+                struct span {
+                    const char *name;
+                    std::uint64_t begin_ns;
+                    std::uint64_t end_ns;
+                };
+
+                static TraceRecorder &instance() {
+                    static TraceRecorder recorder;
+                    return recorder;
+                }
+
+                void enable() {
+                    start = clock::now();
+                    enabled.store(true, std::memory_order_release);
+                }
+
+                bool is_enabled() const noexcept {
+                    return enabled.load(std::memory_order_relaxed);
+                }
+
+                std::uint64_t now_ns() const noexcept {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+                }
+
+                void record(const char *name, std::uint64_t begin_ns, std::uint64_t end_ns) {
+                    auto &buffer = thread_buffer();
+                    if (buffer.chunks.empty() || buffer.chunks.back().size() == CHUNK_SIZE) {
+                        // chunks are never moved, so no copies on growth
+                        buffer.chunks.emplace_back();
+                        buffer.chunks.back().reserve(CHUNK_SIZE);
+                    }
+                    buffer.chunks.back().push_back({name, begin_ns, end_ns});
+                }
+
+                // names the calling thread in the timeline
+                void name_thread(const std::string &name) {
+                    thread_buffer().name = name;
+                }
+
+                // stable copy of a name that is not a literal, e.g., of an algorithm
+                const char *intern(const std::string &name) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return names.insert(name).first->c_str();
+                }
+
+                void write(std::ostream &out) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+                    bool first = true;
+                    for (auto t = 0UL; t < buffers.size(); t++) {
+                        const auto &buffer = *buffers[t];
+                        out << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+                            << t << ", \"args\": {\"name\": ";
+                        write_string(out, buffer.name.empty() ? "thread " + std::to_string(t) : buffer.name);
+                        out << "}}";
+                        first = false;
+                        for (const auto &chunk : buffer.chunks) {
+                            for (const auto &s : chunk) {
+                                out << ",\n{\"name\": ";
+                                write_string(out, s.name);
+                                out << ", \"cat\": \"djmatch\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+                                    << t << ", \"ts\": " << s.begin_ns / 1000 << "." << (s.begin_ns % 1000) / 100
+                                    << ", \"dur\": " << (s.end_ns - s.begin_ns) / 1000 << "."
+                                    << ((s.end_ns - s.begin_ns) % 1000) / 100 << "}";
+                            }
+                        }
+                    }
+                    out << "\n]}\n";
+                }
+
+        private:
+                using clock = std::chrono::steady_clock;
+                static constexpr std::size_t CHUNK_SIZE = 4096;
+
+                struct thread_spans {
+                    std::string name;
+                    std::vector<std::vector<span>> chunks;
+                };
+
+                std::atomic<bool> enabled{false};
+                clock::time_point start{clock::now()};
+                std::mutex mutex;
+                // owned here, as threads may end before the trace is written
+                std::vector<std::unique_ptr<thread_spans>> buffers;
+                std::set<std::string> names;
+
+                TraceRecorder() = default;
+
+                static void write_string(std::ostream &out, const std::string &text) {
+                    out << '"';
+                    for (auto c : text) {
+                        if (c == '"' || c == '\\') {
+                            out << '\\';
+                        }
+                        out << c;
+                    }
+                    out << '"';
+                }
+
+                thread_spans &thread_buffer() {
+                    thread_local thread_spans *buffer = nullptr;
+                    if (buffer == nullptr) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        buffers.emplace_back(new thread_spans());
+                        buffer = buffers.back().get();
+                    }
+                    return *buffer;
+                }
+};
+
+// records the time from construction to destruction as a span, if
+// tracing is enabled
+class ScopedTrace {
+        public:
+                explicit ScopedTrace(const char *name)
+                    : name(TraceRecorder::instance().is_enabled() ? name : nullptr),
+                      begin(this->name != nullptr ? TraceRecorder::instance().now_ns() : 0) { }
+
+                ~ScopedTrace() {
+                    if (name != nullptr) {
+                        auto &recorder = TraceRecorder::instance();
+                        recorder.record(name, begin, recorder.now_ns());
+                    }
+                }
+
+                ScopedTrace(const ScopedTrace&) = delete;
+                ScopedTrace &operator=(const ScopedTrace&) = delete;
+
+        private:
+                const char *name;
+                std::uint64_t begin;
+};
+
+#define DJM_TRACE_CONCAT_(a, b) a##b
+#define DJM_TRACE_CONCAT(a, b) DJM_TRACE_CONCAT_(a, b)
+// DJM_TRACE("name"); records the rest of the enclosing scope as span "name"
+#define DJM_TRACE(name) ScopedTrace DJM_TRACE_CONCAT(djm_trace_, __LINE__)(name)
+
+#endif /* TRACE_H */